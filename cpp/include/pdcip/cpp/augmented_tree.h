@@ -0,0 +1,365 @@
+/**
+ * @file augmented_tree.h
+ * @author Derek Huang
+ * @brief C++ header for trees caching aggregates of their subtrees
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_AUGMENTED_TREE_H_
+#define PDCIP_CPP_AUGMENTED_TREE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/merkle.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Count, sum, minimum, and maximum of the values in a subtree.
+ *
+ * Default constructed, it is the aggregate of no values.
+ */
+struct subtree_aggregate {
+  std::size_t count = 0;
+  double sum = 0;
+  double min = std::numeric_limits<double>::infinity();
+  double max = -std::numeric_limits<double>::infinity();
+
+  /**
+   * Fold another aggregate into this one.
+   *
+   * @param other `const subtree_aggregate&` aggregate of disjoint values
+   */
+  void merge(const subtree_aggregate& other)
+  {
+    count += other.count;
+    sum += other.sum;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+};
+
+/**
+ * Test two `subtree_aggregate` instances for equality.
+ *
+ * @param first `const subtree_aggregate&` first aggregate
+ * @param second `const subtree_aggregate&` second aggregate
+ */
+inline bool operator==(
+  const subtree_aggregate& first, const subtree_aggregate& second)
+{
+  return
+    first.count == second.count &&
+    first.sum == second.sum &&
+    first.min == second.min &&
+    first.max == second.max;
+}
+
+/**
+ * Test two `subtree_aggregate` instances for inequality.
+ *
+ * @param first `const subtree_aggregate&` first aggregate
+ * @param second `const subtree_aggregate&` second aggregate
+ */
+inline bool operator!=(
+  const subtree_aggregate& first, const subtree_aggregate& second)
+{
+  return !(first == second);
+}
+
+/**
+ * Tree node that keeps the aggregate of its subtree's values up to date.
+ *
+ * Every node caches a `subtree_aggregate` and a non-owning pointer to its
+ * parent. Replacing children through `set_children`, or `set_left` and
+ * `set_right` of a `binary_tree`, or changing a value through `set_value`,
+ * recomputes the changed node from its children's cached aggregates and
+ * walks up the parent pointers doing the same, stopping early at the first
+ * ancestor whose aggregate is unchanged. Reading a subtree aggregate is then
+ * `O(1)` and an update costs the sum of the degrees along the path to the
+ * root, instead of a full traversal either way.
+ *
+ * `NAN` values, e.g. of empty `binary_tree` nodes, are not aggregated.
+ *
+ * Each node also caches its Merkle subtree hash, computed like
+ * `merkle_hashes` does. Mutations only mark the node and its ancestors
+ * stale, stopping at the first ancestor already stale, and `hash` rehashes
+ * just the stale nodes bottom-up on demand. Comparing two trees by hash is
+ * then `O(1)` when nothing changed, and `diff` visits only changed regions.
+ *
+ * @note All children must be `augmented_tree<tree_t>` nodes with no other
+ *    parent, so `binary_tree::insert`, which creates plain nodes, cannot be
+ *    used. Values must be changed through `augmented_tree::set_value`, not
+ *    through a base class reference, and the children vector must not be
+ *    modified in place.
+ *
+ * @tparam tree_t `tree` or a subclass such as `binary_tree`
+ */
+template <class tree_t = tree>
+class augmented_tree : public tree_t {
+public:
+  /**
+   * `augmented_tree` constructor giving a node without children.
+   *
+   * @param value `double` node value
+   */
+  augmented_tree(double value = NAN)
+    : tree_t(value), parent_(nullptr), hash_(0), hash_stale_(true)
+  {
+    refresh();
+  }
+
+  /**
+   * `augmented_tree` destructor detaching the children from this node.
+   */
+  ~augmented_tree() override { detach(); }
+
+  /**
+   * Return the parent node, `nullptr` for a root.
+   */
+  augmented_tree* parent() const { return parent_; }
+
+  /**
+   * Return the cached aggregate of the subtree rooted at this node.
+   */
+  const subtree_aggregate& aggregate() const { return aggregate_; }
+
+  /**
+   * Set the node value, updating the aggregates of it and its ancestors.
+   *
+   * @param value `double` new node value
+   */
+  void set_value(double value)
+  {
+    tree_t::set_value(value);
+    propagate();
+    invalidate_hash();
+  }
+
+  /**
+   * Replace the children, updating the aggregates of the node and ancestors.
+   *
+   * @param children `const tree_ptr_vector_ptr&` new children
+   */
+  void set_children(const tree_ptr_vector_ptr& children) override
+  {
+    detach();
+    tree_t::set_children(children);
+    attach();
+    propagate();
+    invalidate_hash();
+  }
+
+  /**
+   * Replace the children by move, updating the node and ancestors.
+   *
+   * @param children `tree_ptr_vector_ptr&&` new children
+   */
+  void set_children(tree_ptr_vector_ptr&& children) override
+  {
+    detach();
+    tree_t::set_children(std::move(children));
+    attach();
+    propagate();
+    invalidate_hash();
+  }
+
+  /**
+   * Return the Merkle hash of the subtree rooted at this node.
+   *
+   * Rehashes stale nodes with an explicit stack, children first, so deep
+   * trees cannot overflow the call stack.
+   */
+  std::uint64_t hash() const
+  {
+    std::vector<std::pair<const augmented_tree*, bool>> stack{{this, false}};
+    while (!stack.empty()) {
+      auto [node, expanded] = stack.back();
+      stack.pop_back();
+      if (!node->hash_stale_) {
+        continue;
+      }
+      if (!expanded) {
+        stack.emplace_back(node, true);
+        node->for_each_child(
+          [&](const augmented_tree* child) { stack.emplace_back(child, false); }
+        );
+        continue;
+      }
+      std::uint64_t result = merkle_value_hash(node->value());
+      if (node->children()) {
+        for (const tree_ptr& child : *node->children()) {
+          result = merkle_combine(
+            result,
+            child ?
+              static_cast<const augmented_tree*>(child.get())->hash_ :
+              merkle_null_hash
+          );
+        }
+      }
+      node->hash_ = result;
+      node->hash_stale_ = false;
+    }
+    return hash_;
+  }
+
+  /**
+   * Return the differing nodes of this subtree and another.
+   *
+   * @param other `const augmented_tree&` root of the other subtree
+   * @returns `changed_node_vector` with pairs of nodes from this subtree and
+   *    `other`, see `diff_subtrees`
+   */
+  changed_node_vector diff(const augmented_tree& other) const
+  {
+    auto hash_of = [](const tree* node)
+    {
+      return static_cast<const augmented_tree*>(node)->hash();
+    };
+    changed_node_vector result;
+    diff_subtrees(this, &other, hash_of, hash_of, result);
+    return result;
+  }
+
+  /**
+   * Recompute every aggregate in the subtree from scratch.
+   *
+   * Only needed to check the cached aggregates, e.g. in tests.
+   *
+   * @returns `subtree_aggregate` of the subtree rooted at this node
+   */
+  subtree_aggregate recompute() const
+  {
+    subtree_aggregate result = own_aggregate();
+    for_each_child(
+      [&](augmented_tree* child) { result.merge(child->recompute()); }
+    );
+    return result;
+  }
+
+private:
+  /**
+   * Call `func(child)` for every non-null child.
+   *
+   * @tparam F callable with signature `void(augmented_tree*)`
+   * @param func `F&&` callable invoked per child
+   */
+  template <typename F>
+  void for_each_child(F&& func) const
+  {
+    if (!this->children()) {
+      return;
+    }
+    for (const tree_ptr& child : *this->children()) {
+      if (child) {
+        func(static_cast<augmented_tree*>(child.get()));
+      }
+    }
+  }
+
+  /**
+   * Return the aggregate of this node's own value alone.
+   */
+  subtree_aggregate own_aggregate() const
+  {
+    subtree_aggregate result;
+    if (!std::isnan(this->value())) {
+      result.count = 1;
+      result.sum = result.min = result.max = this->value();
+    }
+    return result;
+  }
+
+  /**
+   * Recompute this node's aggregate from its value and its children's.
+   */
+  void refresh()
+  {
+    subtree_aggregate result = own_aggregate();
+    for_each_child(
+      [&](augmented_tree* child) { result.merge(child->aggregate_); }
+    );
+    aggregate_ = result;
+  }
+
+  /**
+   * Refresh this node, then its ancestors until one is unchanged.
+   */
+  void propagate()
+  {
+    refresh();
+    for (augmented_tree* node = parent_; node; node = node->parent_) {
+      subtree_aggregate before = node->aggregate_;
+      node->refresh();
+      if (node->aggregate_ == before) {
+        break;
+      }
+    }
+  }
+
+  /**
+   * Mark the hash of this node and its ancestors stale.
+   *
+   * Ancestors of a stale node are always stale, so the walk stops at the
+   * first stale ancestor.
+   */
+  void invalidate_hash()
+  {
+    hash_stale_ = true;
+    for (augmented_tree* node = parent_; node; node = node->parent_) {
+      if (node->hash_stale_) {
+        break;
+      }
+      node->hash_stale_ = true;
+    }
+  }
+
+  /**
+   * Point the current children's parent pointers at this node.
+   */
+  void attach()
+  {
+    if (!this->children()) {
+      return;
+    }
+    for (const tree_ptr& child : *this->children()) {
+      if (!child) {
+        continue;
+      }
+      auto node = dynamic_cast<augmented_tree*>(child.get());
+      assert(node && "children must be augmented_tree nodes");
+      assert(
+        (!node->parent_ || node->parent_ == this) &&
+        "children must not have another parent"
+      );
+      node->parent_ = this;
+    }
+  }
+
+  /**
+   * Clear the parent pointers of the current children.
+   */
+  void detach()
+  {
+    for_each_child([](augmented_tree* child) { child->parent_ = nullptr; });
+  }
+
+  augmented_tree* parent_;
+  subtree_aggregate aggregate_;
+  mutable std::uint64_t hash_;
+  mutable bool hash_stale_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_AUGMENTED_TREE_H_
@@ -0,0 +1,26 @@
+/**
+ * @file betweenness.h
+ * @author Derek Huang
+ * @brief C++ header for betweenness centrality
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_BETWEENNESS_H_
+#define PDCIP_CPP_BETWEENNESS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+double_vector betweenness_centrality(const csr_graph&, std::size_t = 0);
+double_vector approximate_betweenness(
+  const csr_graph&, std::size_t, std::uint64_t = 0, std::size_t = 0
+);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_BETWEENNESS_H_
@@ -0,0 +1,113 @@
+/**
+ * @file bloom_filter.h
+ * @author Derek Huang
+ * @brief C++ header for a cache-line blocked Bloom filter
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_BLOOM_FILTER_H_
+#define PDCIP_CPP_BLOOM_FILTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pdcip {
+
+/**
+ * Split block Bloom filter over pre-hashed 64-bit keys.
+ *
+ * The bit array is split into 64-byte blocks, one cache line each, and a key
+ * only ever touches the block picked by the high half of its hash, so a
+ * lookup costs at most one cache miss. Within the block, the low half of the
+ * hash is multiplied by a different odd salt for each of the 8 words to pick
+ * one bit per word. Building and testing the 8 masks is the same branch-free
+ * operation on every word, which compilers turn into SIMD code without any
+ * platform-specific intrinsics.
+ *
+ * There are no false negatives. With the default 16 bits per key, the false
+ * positive rate is below 0.5%.
+ *
+ * @note Keys should already be well mixed, e.g. by `mix_hash`.
+ */
+class blocked_bloom_filter {
+public:
+  blocked_bloom_filter(std::size_t = 0, double = 16);
+  std::size_t n_blocks() const;
+  std::size_t n_bytes() const;
+  void clear();
+
+  /**
+   * Add a hashed key to the filter.
+   *
+   * @param hash `std::uint64_t` hashed key
+   */
+  void insert(std::uint64_t hash)
+  {
+    block& target = blocks_[block_of(hash)];
+    auto low = static_cast<std::uint32_t>(hash);
+    for (std::size_t i = 0; i < block_words; i++) {
+      target.words[i] |= bit_of(low, i);
+    }
+  }
+
+  /**
+   * Return `false` if a hashed key was definitely never added.
+   *
+   * @param hash `std::uint64_t` hashed key
+   */
+  bool contains(std::uint64_t hash) const
+  {
+    const block& target = blocks_[block_of(hash)];
+    auto low = static_cast<std::uint32_t>(hash);
+    std::uint64_t missing = 0;
+    for (std::size_t i = 0; i < block_words; i++) {
+      missing |= bit_of(low, i) & ~target.words[i];
+    }
+    return !missing;
+  }
+
+private:
+  static constexpr std::size_t block_words = 8;
+
+  /**
+   * 512-bit block aligned to a cache line.
+   */
+  struct alignas(64) block {
+    std::uint64_t words[block_words];
+  };
+
+  /**
+   * Return the index of the block a hash maps to.
+   *
+   * Scales the high 32 bits into `[0, n_blocks)` with a multiply and shift,
+   * which avoids a division and works for any number of blocks.
+   *
+   * @param hash `std::uint64_t` hashed key
+   */
+  std::size_t block_of(std::uint64_t hash) const
+  {
+    return static_cast<std::size_t>(((hash >> 32) * blocks_.size()) >> 32);
+  }
+
+  /**
+   * Return the single-bit mask a hash sets in word `i` of its block.
+   *
+   * @param low `std::uint32_t` low 32 bits of the hashed key
+   * @param i `std::size_t` word index in the block
+   */
+  static std::uint64_t bit_of(std::uint32_t low, std::size_t i)
+  {
+    static constexpr std::uint32_t salts[block_words] = {
+      0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+    };
+    return std::uint64_t(1) << ((low * salts[i]) >> 26);
+  }
+
+  std::vector<block> blocks_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_BLOOM_FILTER_H_
@@ -0,0 +1,38 @@
+/**
+ * @file coloring.h
+ * @author Derek Huang
+ * @brief C++ header for graph coloring
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_COLORING_H_
+#define PDCIP_CPP_COLORING_H_
+
+#include <cstddef>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Assignment of colors to vertices.
+ *
+ * Colors are in `[0, n_colors)` and no two adjacent vertices share a color.
+ */
+struct vertex_coloring {
+  std::size_t n_colors;
+  vertex_index_vector colors;
+};
+
+vertex_index_vector coloring_sequence(const csr_graph&, coloring_order);
+vertex_coloring greedy_coloring(
+  const csr_graph&, coloring_order = coloring_order::smallest_last
+);
+vertex_coloring parallel_coloring(const csr_graph&, std::size_t = 0);
+bool valid_coloring(const csr_graph&, const vertex_index_vector&);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_COLORING_H_
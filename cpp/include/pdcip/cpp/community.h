@@ -0,0 +1,37 @@
+/**
+ * @file community.h
+ * @author Derek Huang
+ * @brief C++ header for community detection algorithms
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_COMMUNITY_H_
+#define PDCIP_CPP_COMMUNITY_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Assignment of vertices to communities.
+ *
+ * Community labels are compacted to `[0, n_communities)`.
+ */
+struct community_assignment {
+  std::size_t n_communities;
+  vertex_index_vector labels;
+};
+
+community_assignment label_propagation(
+  const csr_graph&, std::size_t = 100, std::uint64_t = 0, std::size_t = 0
+);
+community_assignment louvain(const csr_graph&, double = 1e-7);
+double modularity(const csr_graph&, const vertex_index_vector&);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_COMMUNITY_H_
@@ -0,0 +1,126 @@
+/**
+ * @file compressed_graph.h
+ * @author Derek Huang
+ * @brief C++ header for a delta and varint compressed graph representation
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_COMPRESSED_GRAPH_H_
+#define PDCIP_CPP_COMPRESSED_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Decode one LEB128 varint, advancing `p` past it.
+ *
+ * Each byte holds 7 bits of the value, low bits first, with the high bit set
+ * on every byte but the last. Values below 128 take the one-byte fast path.
+ *
+ * @param p `const std::uint8_t*&` read position, advanced past the varint
+ */
+inline std::uint64_t decode_varint(const std::uint8_t*& p)
+{
+  std::uint64_t value = *p++;
+  if (value < 0x80) {
+    return value;
+  }
+  value &= 0x7f;
+  for (unsigned shift = 7; ; shift += 7) {
+    std::uint64_t byte = *p++;
+    value |= (byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+}
+
+/**
+ * Read-only directed graph with delta and varint compressed adjacency.
+ *
+ * Each row starts with the out-degree of its vertex. A non-empty row then
+ * holds the zigzag-encoded difference between its first target and the
+ * source vertex, followed by the gaps between consecutive sorted targets,
+ * all as LEB128 varints. Rows of graphs with locality, e.g. after
+ * reordering, mostly take one byte per edge instead of four.
+ *
+ * Only the byte offset of each row is kept per vertex. Edge indices match
+ * those of the `csr_graph` the graph was built from, and are recovered from
+ * the first edge index of every `edge_sample_interval`-th vertex by adding
+ * up the degrees of the rows in between, so `edges_begin` decodes at most
+ * that many degrees. The graph exposes the same neighbor-iteration interface
+ * as `csr_graph`, with the same `for_each_neighbor` contract, so traversals
+ * written against that interface, e.g. `topological_sort` and `pagerank`,
+ * take either representation. Weights and values are kept uncompressed.
+ */
+class compressed_graph {
+public:
+  compressed_graph();
+  compressed_graph(const csr_graph&, std::size_t = 0);
+  std::size_t n_vertices() const;
+  std::size_t n_edges() const;
+  std::size_t n_bytes() const;
+  bool weighted() const;
+  std::size_t degree(vertex_index) const;
+  edge_index edges_begin(vertex_index) const;
+  edge_index edges_end(vertex_index) const;
+  double weight(edge_index) const;
+  double value(vertex_index) const;
+  bool has_edge(vertex_index, vertex_index) const;
+  vertex_index_vector neighbors(vertex_index) const;
+  edge_index_vector in_degrees() const;
+  csr_graph transpose() const;
+  csr_graph decompress(std::size_t = 0) const;
+
+  /**
+   * Call `func(target, edge)` for each out-edge of a vertex.
+   *
+   * Targets are decoded on the fly in increasing order.
+   *
+   * @tparam F callable with signature `void(vertex_index, edge_index)`
+   * @param vert `vertex_index` vertex whose out-edges are visited
+   * @param func `F&&` callable invoked per out-edge
+   */
+  template <typename F>
+  void for_each_neighbor(vertex_index vert, F&& func) const
+  {
+    const std::uint8_t* p = bytes_.data() + byte_offsets_[vert];
+    std::uint64_t n_left = decode_varint(p);
+    if (!n_left) {
+      return;
+    }
+    edge_index e = edges_begin(vert);
+    std::uint64_t first = decode_varint(p);
+    // undo the zigzag encoding of the signed first delta
+    auto target = static_cast<vertex_index>(
+      vert + static_cast<std::int64_t>((first >> 1) ^ (~(first & 1) + 1))
+    );
+    func(target, e);
+    while (--n_left) {
+      target += static_cast<vertex_index>(decode_varint(p));
+      func(target, ++e);
+    }
+  }
+
+  /**
+   * Number of vertices between consecutive sampled first edge indices.
+   */
+  static constexpr std::size_t edge_sample_interval = 32;
+
+private:
+  edge_index_vector byte_offsets_;
+  edge_index_vector edge_samples_;
+  std::vector<std::uint8_t> bytes_;
+  double_vector weights_;
+  double_vector values_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_COMPRESSED_GRAPH_H_
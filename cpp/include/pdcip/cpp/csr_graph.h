@@ -0,0 +1,111 @@
+/**
+ * @file csr_graph.h
+ * @author Derek Huang
+ * @brief C++ header for a compressed sparse row graph representation
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_CSR_GRAPH_H_
+#define PDCIP_CPP_CSR_GRAPH_H_
+
+#include <cstddef>
+#include <memory>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Read-only directed graph in compressed sparse row (CSR) form.
+ *
+ * Vertices are identified by `vertex_index` values in `[0, n_vertices())`.
+ * The out-edges of vertex `v` occupy the edge index range
+ * `[offsets()[v], offsets()[v + 1])` and each row is sorted by target. Edge
+ * weights are optional; an unweighted graph reports a weight of `1` for every
+ * edge. Vertex values default to `NAN`, matching `vertex`.
+ *
+ * Where `graph` is built for flexible `vertex_ptr` membership queries, this
+ * is the flat representation the graph algorithms run on.
+ *
+ * The arrays are immutable and held through a shared owner, so copies are
+ * cheap and share storage. The owner may also be external memory such as a
+ * memory-mapped file, in which case the graph is a zero-copy view of it.
+ */
+class csr_graph {
+public:
+  csr_graph();
+  csr_graph(const vertex_ptr_vector&, const edge_ptr_vector&);
+  csr_graph(
+    std::size_t,
+    const vertex_index_vector&,
+    const vertex_index_vector&,
+    const double_vector& = double_vector()
+  );
+  csr_graph(
+    edge_index_vector&&,
+    vertex_index_vector&&,
+    double_vector&& = double_vector(),
+    double_vector&& = double_vector()
+  );
+  csr_graph(
+    std::size_t,
+    std::size_t,
+    const edge_index*,
+    const vertex_index*,
+    const double*,
+    const double*,
+    std::shared_ptr<const void>
+  );
+  std::size_t n_vertices() const;
+  std::size_t n_edges() const;
+  bool weighted() const;
+  std::size_t degree(vertex_index) const;
+  const edge_index* offsets() const;
+  const vertex_index* targets() const;
+  const double* weights() const;
+  const double* values() const;
+  edge_index edges_begin(vertex_index) const;
+  edge_index edges_end(vertex_index) const;
+  const vertex_index* neighbors_begin(vertex_index) const;
+  const vertex_index* neighbors_end(vertex_index) const;
+  vertex_index target(edge_index) const;
+  double weight(edge_index) const;
+  double value(vertex_index) const;
+  bool has_edge(vertex_index, vertex_index) const;
+  csr_graph transpose() const;
+  csr_graph symmetrize() const;
+  edge_index_vector in_degrees() const;
+  vertex_index_vector edge_sources() const;
+
+  /**
+   * Call `func(target, edge)` for each out-edge of a vertex.
+   *
+   * @tparam F callable with signature `void(vertex_index, edge_index)`
+   * @param vert `vertex_index` vertex whose out-edges are visited
+   * @param func `F&&` callable invoked per out-edge
+   */
+  template <typename F>
+  void for_each_neighbor(vertex_index vert, F&& func) const
+  {
+    for (edge_index e = offsets_[vert]; e < offsets_[vert + 1]; e++) {
+      func(targets_[e], e);
+    }
+  }
+
+private:
+  void adopt(
+    edge_index_vector&&, vertex_index_vector&&, double_vector&&, double_vector&&
+  );
+
+  std::size_t n_vertices_;
+  std::size_t n_edges_;
+  const edge_index* offsets_;
+  const vertex_index* targets_;
+  const double* weights_;
+  const double* values_;
+  std::shared_ptr<const void> storage_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_CSR_GRAPH_H_
@@ -0,0 +1,49 @@
+/**
+ * @file dag.h
+ * @author Derek Huang
+ * @brief C++ header for topological sorting and DAG task scheduling
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_DAG_H_
+#define PDCIP_CPP_DAG_H_
+
+#include <cstddef>
+#include <functional>
+
+#include "pdcip/cpp/compressed_graph.h"
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Topological order of a directed graph grouped into dependency levels.
+ *
+ * Level `i` holds the vertices `order[level_offsets[i]]` through
+ * `order[level_offsets[i + 1] - 1]`, all of whose dependencies lie in earlier
+ * levels, so the vertices within a level can be processed in parallel. If the
+ * graph has a cycle, vertices on or downstream of the cycle are left out of
+ * `order` and `acyclic()` returns `false`.
+ */
+struct topological_levels {
+  vertex_index_vector order;
+  edge_index_vector level_offsets;
+  std::size_t n_vertices;
+  std::size_t n_levels() const { return level_offsets.size() - 1; }
+  bool acyclic() const { return order.size() == n_vertices; }
+};
+
+topological_levels topological_sort(const csr_graph&);
+topological_levels topological_sort(const compressed_graph&);
+std::size_t dag_schedule(
+  const csr_graph&,
+  const std::function<void(vertex_index)>&,
+  dag_schedule_type = dag_schedule_type::dependency_count,
+  std::size_t = 0
+);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_DAG_H_
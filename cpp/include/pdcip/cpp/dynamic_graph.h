@@ -0,0 +1,96 @@
+/**
+ * @file dynamic_graph.h
+ * @author Derek Huang
+ * @brief C++ header for a mutable graph with batched edge updates
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_DYNAMIC_GRAPH_H_
+#define PDCIP_CPP_DYNAMIC_GRAPH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Mutable directed graph built for high rates of batched edge updates.
+ *
+ * Every vertex owns a sorted, growable array of unique targets and, if the
+ * graph is weighted, a parallel array of weights. A batch of insertions or
+ * deletions is sorted once by source and target, then each affected row is
+ * merged with its slice of the batch on its own thread, so updates need no
+ * locks. `to_csr` compacts the graph into a `csr_graph` for read-heavy
+ * phases.
+ */
+class dynamic_graph {
+public:
+  dynamic_graph(std::size_t = 0, bool = false);
+  dynamic_graph(const csr_graph&);
+  std::size_t n_vertices() const;
+  std::size_t n_edges() const;
+  bool weighted() const;
+  std::size_t degree(vertex_index) const;
+  bool has_edge(vertex_index, vertex_index) const;
+  double weight(vertex_index, vertex_index) const;
+  double value(vertex_index) const;
+  void set_value(vertex_index, double);
+  void add_vertices(std::size_t);
+  std::size_t insert_edges(
+    const vertex_index_vector&,
+    const vertex_index_vector&,
+    const double_vector& = double_vector(),
+    std::size_t = 0
+  );
+  std::size_t remove_edges(
+    const vertex_index_vector&, const vertex_index_vector&, std::size_t = 0
+  );
+  csr_graph to_csr(std::size_t = 0) const;
+
+  /**
+   * Call `func(target, weight)` for each out-edge of a vertex.
+   *
+   * Targets are visited in increasing order. Unlike `csr_graph`, edges have
+   * no stable index, so the weight is passed directly.
+   *
+   * @tparam F callable with signature `void(vertex_index, double)`
+   * @param vert `vertex_index` vertex whose out-edges are visited
+   * @param func `F&&` callable invoked per out-edge
+   */
+  template <typename F>
+  void for_each_neighbor(vertex_index vert, F&& func) const
+  {
+    const row& adjacent = rows_[vert];
+    for (std::size_t i = 0; i < adjacent.targets.size(); i++) {
+      func(
+        adjacent.targets[i],
+        (weighted_) ? adjacent.weights[i] : 1.
+      );
+    }
+  }
+
+private:
+  /**
+   * Sorted out-edges of one vertex.
+   */
+  struct row {
+    vertex_index_vector targets;
+    double_vector weights;
+  };
+
+  edge_index_vector sort_batch(
+    const vertex_index_vector&, const vertex_index_vector&, std::size_t
+  ) const;
+
+  std::vector<row> rows_;
+  double_vector values_;
+  std::size_t n_edges_;
+  bool weighted_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_DYNAMIC_GRAPH_H_
@@ -23,6 +23,32 @@ enum class algo_loop_type {recursive, iterative};
  */
 enum class search_strategy {exact, from_above, from_below};
 
+/**
+ * Enum type dictating how a DAG of tasks is scheduled across threads.
+ *
+ * `level_sync` runs each topological level in parallel with a barrier between
+ * levels, `dependency_count` starts each task as soon as its last dependency
+ * has finished.
+ */
+enum class dag_schedule_type {level_sync, dependency_count};
+
+/**
+ * Enum type dictating the order greedy graph coloring visits vertices in.
+ *
+ * `natural` visits vertices by index, `largest_first` by nonincreasing
+ * degree, `smallest_last` in reverse of the order that repeatedly removes a
+ * vertex of minimum remaining degree.
+ */
+enum class coloring_order {natural, largest_first, smallest_last};
+
+/**
+ * Enum type indicating the kind of a tree edit.
+ *
+ * `insert` adds a new childless node, `remove` deletes a subtree, `update`
+ * changes a node value, `move` detaches a subtree and attaches it elsewhere.
+ */
+enum class tree_edit_type {insert, remove, update, move};
+
 }  // namespace pdcip
 
 #endif  // PDCIP_CPP_ENUMS_H_
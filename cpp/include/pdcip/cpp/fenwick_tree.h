@@ -0,0 +1,41 @@
+/**
+ * @file fenwick_tree.h
+ * @author Derek Huang
+ * @brief C++ header for a Fenwick (binary indexed) tree
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_FENWICK_TREE_H_
+#define PDCIP_CPP_FENWICK_TREE_H_
+
+#include <cstddef>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Fenwick tree over a `double_vector` with point updates and range sums.
+ *
+ * Slot `i` of the flat array holds the sum of the `i & -i` values ending at
+ * position `i - 1`, so both a prefix sum and a point update touch one slot
+ * per set bit of the position, i.e. `O(log n)`. It needs half the memory of
+ * a `segment_tree` and is faster when only sums and single-value updates are
+ * needed.
+ */
+class fenwick_tree {
+public:
+  fenwick_tree(const double_vector& = double_vector());
+  std::size_t size() const;
+  void add(std::size_t, double);
+  void set(std::size_t, double);
+  double prefix_sum(std::size_t) const;
+  double sum(std::size_t, std::size_t) const;
+  double value(std::size_t) const;
+private:
+  double_vector sums_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_FENWICK_TREE_H_
@@ -0,0 +1,288 @@
+/**
+ * @file flat_hash_map.h
+ * @author Derek Huang
+ * @brief C++ header for a flat open-addressing hash map with integer keys
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_FLAT_HASH_MAP_H_
+#define PDCIP_CPP_FLAT_HASH_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace pdcip {
+
+/**
+ * Mix the bits of a 64-bit key, the finalizer of the SplitMix64 generator.
+ *
+ * Keys like packed vertex index pairs or pointers have most of their entropy
+ * in a few bits, so they are scrambled before masking to a table index.
+ *
+ * @param key `std::uint64_t` key to hash
+ */
+inline std::uint64_t mix_hash(std::uint64_t key)
+{
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ULL;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+  return key;
+}
+
+/**
+ * Flat hash map from `std::uint64_t` keys using Robin Hood open addressing.
+ *
+ * Keys, values, and probe distances live in three flat arrays, so a lookup
+ * is a hash, a mask, and a short linear scan with no pointer chasing. On
+ * insertion, an entry that has probed farther than the resident entry takes
+ * its slot and the resident moves on, which bounds the variance of probe
+ * lengths and lets an unsuccessful lookup stop as soon as it meets an entry
+ * closer to its home slot than the probe itself. Erasure shifts following
+ * entries back instead of leaving tombstones. The table doubles once it is
+ * 7/8 full.
+ *
+ * @note Pointers and references to values are invalidated by `emplace`,
+ *    `erase`, and `reserve`.
+ *
+ * @tparam value_t mapped type, default constructible and movable, not `bool`
+ */
+template <typename value_t>
+class flat_hash_map {
+public:
+  /**
+   * `flat_hash_map` default constructor giving an empty map.
+   */
+  flat_hash_map() : size_(0), mask_(0) {}
+
+  /**
+   * Return number of entries in the map.
+   */
+  std::size_t size() const { return size_; }
+
+  /**
+   * Return `true` if the map has no entries.
+   */
+  bool empty() const { return !size_; }
+
+  /**
+   * Return number of slots in the table.
+   */
+  std::size_t capacity() const { return distances_.size(); }
+
+  /**
+   * Return pointer to the value of a key, `nullptr` if absent.
+   *
+   * @param key `std::uint64_t` key to look up
+   */
+  const value_t* find(std::uint64_t key) const
+  {
+    std::size_t slot = locate(key);
+    return (slot == npos) ? nullptr : &values_[slot];
+  }
+
+  /**
+   * Return pointer to the value of a key, `nullptr` if absent.
+   *
+   * @param key `std::uint64_t` key to look up
+   */
+  value_t* find(std::uint64_t key)
+  {
+    std::size_t slot = locate(key);
+    return (slot == npos) ? nullptr : &values_[slot];
+  }
+
+  /**
+   * Return `true` if the map has an entry for a key.
+   *
+   * @param key `std::uint64_t` key to look up
+   */
+  bool contains(std::uint64_t key) const { return locate(key) != npos; }
+
+  /**
+   * Return the value of a key, inserting a default value if absent.
+   *
+   * @param key `std::uint64_t` key to look up or insert
+   * @returns `std::pair<value_t&, bool>` with the value and `true` if the key
+   *    was inserted
+   */
+  std::pair<value_t&, bool> emplace(std::uint64_t key)
+  {
+    std::size_t slot = locate(key);
+    if (slot != npos) {
+      return {values_[slot], false};
+    }
+    if (8 * (size_ + 1) > 7 * capacity()) {
+      reserve(2 * size_ + 2);
+    }
+    return {values_[insert(key, value_t())], true};
+  }
+
+  /**
+   * Remove the entry for a key, if present.
+   *
+   * Following entries that are displaced from their home slot are shifted
+   * back by one, keeping every probe sequence unbroken.
+   *
+   * @param key `std::uint64_t` key to remove
+   * @returns `true` if an entry was removed
+   */
+  bool erase(std::uint64_t key)
+  {
+    std::size_t slot = locate(key);
+    if (slot == npos) {
+      return false;
+    }
+    std::size_t next = (slot + 1) & mask_;
+    while (distances_[next] > 1) {
+      keys_[slot] = keys_[next];
+      values_[slot] = std::move(values_[next]);
+      distances_[slot] = static_cast<std::uint8_t>(distances_[next] - 1);
+      slot = next;
+      next = (next + 1) & mask_;
+    }
+    distances_[slot] = 0;
+    values_[slot] = value_t();
+    size_--;
+    return true;
+  }
+
+  /**
+   * Grow the table so it can hold at least `count` entries without growing.
+   *
+   * @param count `std::size_t` number of entries to make room for
+   */
+  void reserve(std::size_t count)
+  {
+    std::size_t n_slots = 8;
+    while (7 * n_slots < 8 * count) {
+      n_slots *= 2;
+    }
+    if (n_slots <= capacity()) {
+      return;
+    }
+    std::vector<std::uint64_t> keys(n_slots);
+    std::vector<value_t> values(n_slots);
+    std::vector<std::uint8_t> distances(n_slots, 0);
+    keys.swap(keys_);
+    values.swap(values_);
+    distances.swap(distances_);
+    mask_ = n_slots - 1;
+    size_ = 0;
+    for (std::size_t i = 0; i < distances.size(); i++) {
+      if (distances[i]) {
+        insert(keys[i], std::move(values[i]));
+      }
+    }
+  }
+
+  /**
+   * Remove all entries, keeping the capacity.
+   */
+  void clear()
+  {
+    for (std::size_t i = 0; i < distances_.size(); i++) {
+      if (distances_[i]) {
+        distances_[i] = 0;
+        values_[i] = value_t();
+      }
+    }
+    size_ = 0;
+  }
+
+  /**
+   * Call `func(key, value)` for every entry, in table order.
+   *
+   * @tparam F callable with signature `void(std::uint64_t, const value_t&)`
+   * @param func `F&&` callable invoked per entry
+   */
+  template <typename F>
+  void for_each(F&& func) const
+  {
+    for (std::size_t i = 0; i < distances_.size(); i++) {
+      if (distances_[i]) {
+        func(keys_[i], values_[i]);
+      }
+    }
+  }
+
+private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+  static constexpr std::uint8_t max_distance = 255;
+
+  /**
+   * Return the slot holding a key, `npos` if absent.
+   *
+   * @param key `std::uint64_t` key to look up
+   */
+  std::size_t locate(std::uint64_t key) const
+  {
+    if (!size_) {
+      return npos;
+    }
+    std::size_t slot = static_cast<std::size_t>(mix_hash(key)) & mask_;
+    // distances are stored plus one so that zero marks an empty slot
+    for (unsigned int dist = 1; dist <= distances_[slot]; dist++) {
+      if (distances_[slot] == dist && keys_[slot] == key) {
+        return slot;
+      }
+      slot = (slot + 1) & mask_;
+    }
+    return npos;
+  }
+
+  /**
+   * Insert a key known to be absent, with room in the table.
+   *
+   * If the entry being carried would probe farther than a stored distance
+   * can record, the table is doubled, which spreads the cluster out, and the
+   * carried entry is inserted into the grown table.
+   *
+   * @param key `std::uint64_t` key to insert
+   * @param value `value_t&&` value to insert
+   * @returns `std::size_t` slot the key ended up in
+   */
+  std::size_t insert(std::uint64_t key, value_t&& value)
+  {
+    std::uint64_t inserted = key;
+    std::size_t slot = static_cast<std::size_t>(mix_hash(key)) & mask_;
+    std::size_t result = npos;
+    std::uint8_t dist = 1;
+    while (distances_[slot]) {
+      // take from the rich: displace entries closer to their home slot
+      if (distances_[slot] < dist) {
+        std::swap(key, keys_[slot]);
+        std::swap(value, values_[slot]);
+        std::swap(dist, distances_[slot]);
+        if (result == npos) {
+          result = slot;
+        }
+      }
+      if (dist == max_distance) {
+        reserve(capacity());
+        insert(key, std::move(value));
+        return locate(inserted);
+      }
+      dist++;
+      slot = (slot + 1) & mask_;
+    }
+    keys_[slot] = key;
+    values_[slot] = std::move(value);
+    distances_[slot] = dist;
+    size_++;
+    return (result == npos) ? slot : result;
+  }
+
+  std::vector<std::uint64_t> keys_;
+  std::vector<value_t> values_;
+  std::vector<std::uint8_t> distances_;
+  std::size_t size_;
+  std::size_t mask_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_FLAT_HASH_MAP_H_
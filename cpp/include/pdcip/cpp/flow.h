@@ -0,0 +1,40 @@
+/**
+ * @file flow.h
+ * @author Derek Huang
+ * @brief C++ header for maximum flow and minimum cut algorithms
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_FLOW_H_
+#define PDCIP_CPP_FLOW_H_
+
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Maximum flow between two vertices together with a minimum cut.
+ *
+ * `edge_flows[e]` is the flow on `csr_graph` edge `e`, `source_side[v]` is
+ * `true` for vertices reachable from the source in the final residual graph,
+ * and `cut_edges` lists the saturated edges from the source side to the sink
+ * side, whose capacities sum up to `value`.
+ */
+struct flow_result {
+  double value;
+  double_vector edge_flows;
+  std::vector<bool> source_side;
+  edge_index_vector cut_edges;
+};
+
+flow_result push_relabel_max_flow(
+  const csr_graph&, vertex_index, vertex_index
+);
+flow_result dinic_max_flow(const csr_graph&, vertex_index, vertex_index);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_FLOW_H_
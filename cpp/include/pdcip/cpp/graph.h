@@ -10,18 +10,45 @@
 
 #include <cmath>
 #include <cstddef>
-#include <unordered_map>
+#include <cstdint>
+#include <optional>
 #include <utility>
 
+#include "pdcip/cpp/bloom_filter.h"
+#include "pdcip/cpp/flat_hash_map.h"
 #include "pdcip/cpp/types.h"
 
 namespace pdcip {
 
-using graph_vertex_map = std::unordered_map<vertex_ptr, std::nullptr_t>;
-using graph_edge_map = std::unordered_map<
-  std::pair<vertex_ptr, vertex_ptr>,
-  std::shared_ptr<std::unordered_map<double, std::nullptr_t>>
->;
+/**
+ * Distinct weights of the edges joining one ordered pair of vertices.
+ *
+ * Almost every vertex pair has a single edge, so the first two weights are
+ * stored inline and only further weights go to a heap-allocated overflow.
+ */
+class edge_weights {
+public:
+  edge_weights();
+  std::size_t size() const;
+  double operator[](std::size_t) const;
+  bool contains(double) const;
+  bool insert(double);
+private:
+  static constexpr std::size_t n_inline = 2;
+  std::size_t size_;
+  double inline_[n_inline];
+  double_vector overflow_;
+};
+
+/**
+ * Map from vertex pointer address to the vertex's index in a `graph`.
+ */
+using graph_vertex_map = flat_hash_map<vertex_index>;
+
+/**
+ * Map from packed `(start, end)` vertex index pair to the edge weights.
+ */
+using graph_edge_map = flat_hash_map<edge_weights>;
 
 /**
  * Graph vertex class for holding numeric data.
@@ -69,12 +96,22 @@ bool operator!=(const edge&, const edge&);
  * @note Does not support duplicated edges in the graph, i.e. edges that have
  *     identical start, end vertices and edge weight.
  *
- * Uses `std::unordered_map` to allow constant time checking of edge
- * connectivity to emulate adjacency matrix lookup performance while minimizing
- * memory use. Edge + vertex membership checking is also constant due to this.
+ * Vertices are numbered in order of insertion, and edges are indexed by the
+ * start and end vertex indices packed into one 64-bit key of a flat Robin
+ * Hood hash table, so `has_edge` and `connects` are a hash and a short linear
+ * probe with no per-edge allocation, emulating adjacency matrix lookup
+ * performance while using memory proportional to the number of edges.
+ *
+ * Optionally, a blocked Bloom filter over vertex pointer pairs is kept next to
+ * the edge table. Since the filter is keyed by pointer addresses, a negative
+ * `has_edge` or `connects` then usually returns after touching one cache line
+ * without consulting either hash table.
+ *
+ * @note Adding an edge also adds its vertices if they are not in the graph.
  */
 class graph {
 public:
+  graph();
   graph(const vertex_ptr_vector&, const edge_ptr_vector&);
   graph(const vertex_ptr_vector_ptr&, const edge_ptr_vector_ptr&);
   graph(vertex_ptr_vector_ptr&&, edge_ptr_vector_ptr&&);
@@ -90,15 +127,29 @@ public:
   void add_edge(edge_ptr&&);
   void add_edges(const edge_ptr_vector&);
   void add_edges(const edge_ptr_vector_ptr&);
-  bool has_vertex(const vertex_ptr&);
-  bool has_edge(const edge_ptr&);
-  bool has_edge(edge_ptr&&);
-  bool has_edge(const edge&);
-  bool has_edge(edge&&);
-  bool connects(const vertex_ptr&, const vertex_ptr&, bool = true);
+  bool has_vertex(const vertex_ptr&) const;
+  bool has_edge(const edge_ptr&) const;
+  bool has_edge(edge_ptr&&) const;
+  bool has_edge(const edge&) const;
+  bool has_edge(edge&&) const;
+  bool connects(const vertex_ptr&, const vertex_ptr&, bool = true) const;
+  void enable_edge_filter(double = 16);
+  void disable_edge_filter();
+  bool has_edge_filter() const;
 private:
+  static std::uint64_t vertex_key(const vertex_ptr&);
+  static std::uint64_t edge_key(vertex_index, vertex_index);
+  static std::uint64_t filter_key(const vertex_ptr&, const vertex_ptr&);
+  void build_edge_filter(std::size_t);
+  const vertex_index* find_vertex(const vertex_ptr&) const;
+  const edge_weights* find_weights(const vertex_ptr&, const vertex_ptr&) const;
+  vertex_ptr_vector vertex_list_;
+  edge_ptr_vector edge_list_;
   graph_vertex_map vertices_;
   graph_edge_map edges_;
+  std::optional<blocked_bloom_filter> filter_;
+  std::size_t filter_capacity_ = 0;
+  double filter_bits_ = 0;
 };
 
 }  // namespace pdcip
@@ -0,0 +1,32 @@
+/**
+ * @file graph_io.h
+ * @author Derek Huang
+ * @brief C++ header for loading graphs from text files
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_GRAPH_IO_H_
+#define PDCIP_CPP_GRAPH_IO_H_
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+#include "pdcip/cpp/csr_graph.h"
+
+namespace pdcip {
+
+std::optional<csr_graph> parse_edge_list(
+  const char*, std::size_t, std::size_t = 0
+);
+std::optional<csr_graph> parse_matrix_market(
+  const char*, std::size_t, std::size_t = 0
+);
+std::optional<csr_graph> read_edge_list(const std::string&, std::size_t = 0);
+std::optional<csr_graph> read_matrix_market(
+  const std::string&, std::size_t = 0
+);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_GRAPH_IO_H_
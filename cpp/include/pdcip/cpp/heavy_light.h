@@ -0,0 +1,74 @@
+/**
+ * @file heavy_light.h
+ * @author Derek Huang
+ * @brief C++ header for heavy-light decomposition of trees
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_HEAVY_LIGHT_H_
+#define PDCIP_CPP_HEAVY_LIGHT_H_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Sum, minimum, and maximum of a set of values.
+ *
+ * Default constructed, it is the aggregate of no values.
+ */
+struct path_aggregate {
+  double sum = 0;
+  double min = std::numeric_limits<double>::infinity();
+  double max = -std::numeric_limits<double>::infinity();
+};
+
+/**
+ * Heavy-light decomposition of a `tree` answering path aggregate queries.
+ *
+ * Each node's child with the largest subtree is its heavy child, and chains
+ * of heavy children form heavy paths. Nodes are numbered so every heavy path
+ * is a contiguous range, and since a walk up from any node crosses at most
+ * `O(log n)` light edges, any tree path splits into `O(log n)` ranges. A
+ * segment tree over the numbered node values aggregates each range in
+ * `O(log n)`, so path queries take `O(log^2 n)` and value updates
+ * `O(log n)`.
+ *
+ * @note The decomposition refers to the nodes present at construction, so it
+ *    must be rebuilt after the tree's shape is changed. Node values must be
+ *    changed through `set_value` to be seen by queries.
+ */
+class heavy_light {
+public:
+  heavy_light(const tree_ptr&);
+  std::size_t n_nodes() const;
+  vertex_index index(const tree_ptr&) const;
+  const tree_ptr& node(vertex_index) const;
+  vertex_index parent(vertex_index) const;
+  vertex_index depth(vertex_index) const;
+  vertex_index head(vertex_index) const;
+  double value(vertex_index) const;
+  void set_value(vertex_index, double);
+  path_aggregate query_path(vertex_index, vertex_index) const;
+  double path_sum(vertex_index, vertex_index) const;
+  double path_min(vertex_index, vertex_index) const;
+  double path_max(vertex_index, vertex_index) const;
+private:
+  path_aggregate query_range(std::size_t, std::size_t) const;
+  tree_ptr_vector nodes_;
+  vertex_index_vector parents_;
+  vertex_index_vector depths_;
+  vertex_index_vector heads_;
+  std::vector<path_aggregate> segments_;
+  flat_hash_map<vertex_index> indices_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_HEAVY_LIGHT_H_
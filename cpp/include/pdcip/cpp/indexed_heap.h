@@ -0,0 +1,204 @@
+/**
+ * @file indexed_heap.h
+ * @author Derek Huang
+ * @brief C++ header for an indexed binary min-heap over vertex indices
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_INDEXED_HEAP_H_
+#define PDCIP_CPP_INDEXED_HEAP_H_
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Binary min-heap of `vertex_index` items keyed by `key_t` with decrease-key.
+ *
+ * Each item's heap position is tracked in a flat array so `push_or_decrease`
+ * runs in `O(log n)` without duplicate entries, which keeps Prim's and
+ * Dijkstra's algorithms at `O(E log V)` with a heap no larger than `V`.
+ *
+ * @tparam key_t totally ordered key type, e.g. `double`
+ */
+template <typename key_t>
+class indexed_heap {
+public:
+  /**
+   * `indexed_heap` constructor.
+   *
+   * @param capacity `std::size_t` one past the largest item that can be pushed
+   */
+  indexed_heap(std::size_t capacity)
+    : keys_(capacity), positions_(capacity, npos)
+  {}
+
+  /**
+   * Return `true` if the heap has no items.
+   */
+  bool empty() const { return items_.empty(); }
+
+  /**
+   * Return number of items in the heap.
+   */
+  std::size_t size() const { return items_.size(); }
+
+  /**
+   * Return `true` if `item` is currently in the heap.
+   *
+   * @param item `vertex_index` item to check
+   */
+  bool contains(vertex_index item) const { return positions_[item] != npos; }
+
+  /**
+   * Return the item with the smallest key.
+   */
+  vertex_index top() const
+  {
+    assert(!empty());
+    return items_.front();
+  }
+
+  /**
+   * Return the key of an item in the heap.
+   *
+   * @param item `vertex_index` item in the heap
+   */
+  const key_t& key(vertex_index item) const { return keys_[item]; }
+
+  /**
+   * Insert an item, or lower its key if it is present with a larger key.
+   *
+   * @param item `vertex_index` item to insert or update
+   * @param key `const key_t&` new key
+   * @returns `true` if the item was inserted or its key was lowered
+   */
+  bool push_or_decrease(vertex_index item, const key_t& key)
+  {
+    if (!contains(item)) {
+      keys_[item] = key;
+      positions_[item] = items_.size();
+      items_.push_back(item);
+    }
+    else if (key < keys_[item]) {
+      keys_[item] = key;
+    }
+    else {
+      return false;
+    }
+    sift_up(positions_[item]);
+    return true;
+  }
+
+  /**
+   * Change the key of an item in the heap, raising or lowering it.
+   *
+   * @param item `vertex_index` item in the heap
+   * @param key `const key_t&` new key
+   */
+  void update(vertex_index item, const key_t& key)
+  {
+    assert(contains(item));
+    keys_[item] = key;
+    sift_up(positions_[item]);
+    sift_down(positions_[item]);
+  }
+
+  /**
+   * Remove and return the item with the smallest key.
+   */
+  vertex_index pop()
+  {
+    vertex_index item = top();
+    positions_[item] = npos;
+    if (items_.size() > 1) {
+      items_.front() = items_.back();
+      positions_[items_.front()] = 0;
+      items_.pop_back();
+      sift_down(0);
+    }
+    else {
+      items_.pop_back();
+    }
+    return item;
+  }
+
+  /**
+   * Remove all items in `O(size())` time, keeping the capacity.
+   */
+  void clear()
+  {
+    for (vertex_index item : items_) {
+      positions_[item] = npos;
+    }
+    items_.clear();
+  }
+
+private:
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * Move the item at heap position `pos` up until the heap property holds.
+   *
+   * @param pos `std::size_t` heap position
+   */
+  void sift_up(std::size_t pos)
+  {
+    vertex_index item = items_[pos];
+    while (pos) {
+      std::size_t parent = (pos - 1) / 2;
+      if (!(keys_[item] < keys_[items_[parent]])) {
+        break;
+      }
+      items_[pos] = items_[parent];
+      positions_[items_[pos]] = pos;
+      pos = parent;
+    }
+    items_[pos] = item;
+    positions_[item] = pos;
+  }
+
+  /**
+   * Move the item at heap position `pos` down until the heap property holds.
+   *
+   * @param pos `std::size_t` heap position
+   */
+  void sift_down(std::size_t pos)
+  {
+    vertex_index item = items_[pos];
+    while (true) {
+      std::size_t child = 2 * pos + 1;
+      if (child >= items_.size()) {
+        break;
+      }
+      if (
+        child + 1 < items_.size() &&
+        keys_[items_[child + 1]] < keys_[items_[child]]
+      ) {
+        child++;
+      }
+      if (!(keys_[items_[child]] < keys_[item])) {
+        break;
+      }
+      items_[pos] = items_[child];
+      positions_[items_[pos]] = pos;
+      pos = child;
+    }
+    items_[pos] = item;
+    positions_[item] = pos;
+  }
+
+  std::vector<key_t> keys_;
+  std::vector<std::size_t> positions_;
+  vertex_index_vector items_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_INDEXED_HEAP_H_
@@ -0,0 +1,34 @@
+/**
+ * @file intersect.h
+ * @author Derek Huang
+ * @brief C++ header for sorted set intersection kernels
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_INTERSECT_H_
+#define PDCIP_CPP_INTERSECT_H_
+
+#include <cstddef>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+std::size_t intersect_sorted(
+  const vertex_index*,
+  const vertex_index*,
+  const vertex_index*,
+  const vertex_index*,
+  vertex_index* = nullptr
+);
+std::size_t intersect_sorted_scalar(
+  const vertex_index*,
+  const vertex_index*,
+  const vertex_index*,
+  const vertex_index*,
+  vertex_index* = nullptr
+);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_INTERSECT_H_
@@ -0,0 +1,51 @@
+/**
+ * @file interval_tree.h
+ * @author Derek Huang
+ * @brief C++ header for a static augmented interval tree
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_INTERVAL_TREE_H_
+#define PDCIP_CPP_INTERVAL_TREE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Interval tree built in bulk over closed `double_pair` intervals.
+ *
+ * Intervals are sorted by start into flat arrays, which double as an
+ * implicit perfectly balanced binary search tree: node `i` sits at level
+ * `k`, the number of trailing one bits of `i`, with children `i - 2^(k-1)`
+ * and `i + 2^(k-1)`, so its subtree is the contiguous range `i +/- (2^k - 1)`
+ * and its smallest start is the first of that range. Each node also stores
+ * the largest end in its subtree, so a query skips every subtree ending
+ * before it or starting after it. A subtree that passes both checks need not
+ * hold a match, so reporting `m` matches takes `O(min(n, (m + 1) log n))`.
+ * Queries walk the tree with a fixed-size stack and append to a caller-owned
+ * buffer, so they never allocate once the buffer has grown.
+ *
+ * @note Intervals are closed, so `(1, 2)` and `(2, 3)` overlap.
+ */
+class interval_tree {
+public:
+  interval_tree(const std::vector<double_pair>& = std::vector<double_pair>());
+  std::size_t size() const;
+  std::size_t stab(double, std::vector<std::size_t>&) const;
+  std::size_t overlap(double, double, std::vector<std::size_t>&) const;
+private:
+  std::size_t n_intervals_;
+  std::size_t height_;
+  double_vector starts_;
+  double_vector ends_;
+  double_vector max_ends_;
+  std::vector<std::size_t> ids_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_INTERVAL_TREE_H_
@@ -0,0 +1,35 @@
+/**
+ * @file kcore.h
+ * @author Derek Huang
+ * @brief C++ header for k-core decomposition
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_KCORE_H_
+#define PDCIP_CPP_KCORE_H_
+
+#include <cstddef>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Result of peeling a graph by repeatedly removing a minimum degree vertex.
+ *
+ * `order` lists vertices in the order they were removed, so its reverse is a
+ * degeneracy ordering, and `cores` gives the core number of each vertex.
+ */
+struct degeneracy_peeling {
+  vertex_index_vector order;
+  vertex_index_vector cores;
+};
+
+degeneracy_peeling peel_by_degree(const csr_graph&);
+vertex_index_vector core_numbers(const csr_graph&);
+vertex_index_vector parallel_core_numbers(const csr_graph&, std::size_t = 0);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_KCORE_H_
@@ -0,0 +1,62 @@
+/**
+ * @file lca.h
+ * @author Derek Huang
+ * @brief C++ header for lowest common ancestor queries on trees
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_LCA_H_
+#define PDCIP_CPP_LCA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Lowest common ancestor index over a `tree` using an Euler tour.
+ *
+ * Nodes are numbered in pre-order. The Euler tour lists a node every time
+ * the depth-first walk enters or returns to it, so the lowest common
+ * ancestor of two nodes is the shallowest node on the tour between their
+ * first occurrences. A sparse table holding the shallowest node of every
+ * power-of-two window of the tour answers that range minimum with two
+ * overlapping lookups. Building takes `O(n log n)` time and space, and each
+ * query takes `O(1)`.
+ *
+ * @note The index refers to the nodes present at construction, so it must be
+ *    rebuilt after the tree is changed.
+ */
+class lca_index {
+public:
+  lca_index(const tree_ptr&);
+  std::size_t n_nodes() const;
+  vertex_index index(const tree_ptr&) const;
+  const tree_ptr& node(vertex_index) const;
+  vertex_index parent(vertex_index) const;
+  vertex_index depth(vertex_index) const;
+  vertex_index lca(vertex_index, vertex_index) const;
+  tree_ptr lca(const tree_ptr&, const tree_ptr&) const;
+private:
+  vertex_index shallower(vertex_index, vertex_index) const;
+  tree_ptr_vector nodes_;
+  vertex_index_vector parents_;
+  vertex_index_vector depths_;
+  vertex_index_vector first_;
+  std::vector<vertex_index_vector> table_;
+  std::vector<std::uint8_t> log2_;
+  flat_hash_map<vertex_index> indices_;
+};
+
+tree_ptr_vector tarjan_lca(
+  const tree_ptr&, const tree_ptr_vector&, const tree_ptr_vector&
+);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_LCA_H_
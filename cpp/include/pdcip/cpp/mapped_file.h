@@ -0,0 +1,48 @@
+/**
+ * @file mapped_file.h
+ * @author Derek Huang
+ * @brief C++ header for read-only memory-mapped files
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_MAPPED_FILE_H_
+#define PDCIP_CPP_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace pdcip {
+
+/**
+ * Read-only view of a whole file mapped into memory.
+ *
+ * Pages are loaded lazily by the OS and shared through the page cache with
+ * every other process mapping the same file. The mapping is released on
+ * destruction or `close`. Moving transfers ownership of the mapping.
+ */
+class mapped_file {
+public:
+  mapped_file();
+  mapped_file(const std::string&);
+  mapped_file(const mapped_file&) = delete;
+  mapped_file(mapped_file&&) noexcept;
+  ~mapped_file();
+  mapped_file& operator=(const mapped_file&) = delete;
+  mapped_file& operator=(mapped_file&&) noexcept;
+  bool is_open() const;
+  const char* data() const;
+  std::size_t size() const;
+  void close();
+
+private:
+  bool open_;
+  const char* data_;
+  std::size_t size_;
+#ifdef _WIN32
+  void* mapping_;
+#endif  // _WIN32
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_MAPPED_FILE_H_
@@ -0,0 +1,51 @@
+/**
+ * @file matching.h
+ * @author Derek Huang
+ * @brief C++ header for bipartite matching and assignment algorithms
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_MATCHING_H_
+#define PDCIP_CPP_MATCHING_H_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Marker for a vertex, row, or column that is not matched.
+ */
+constexpr vertex_index unmatched = std::numeric_limits<vertex_index>::max();
+
+/**
+ * Maximum-cardinality matching of a bipartite graph.
+ *
+ * `mates[v]` is the vertex `v` is matched to, or `unmatched`.
+ */
+struct bipartite_matching {
+  std::size_t size;
+  vertex_index_vector mates;
+};
+
+/**
+ * Minimum-cost assignment of rows to columns of a dense cost matrix.
+ *
+ * `columns[i]` is the column assigned to row `i`, or `unmatched` if there are
+ * more rows than columns and row `i` was left out.
+ */
+struct assignment {
+  double cost;
+  vertex_index_vector columns;
+};
+
+bipartite_matching hopcroft_karp(const csr_graph&, const std::vector<bool>&);
+assignment hungarian_assignment(const double_vector&, std::size_t, std::size_t);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_MATCHING_H_
@@ -0,0 +1,175 @@
+/**
+ * @file merkle.h
+ * @author Derek Huang
+ * @brief C++ header for Merkle hashing of trees
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_MERKLE_H_
+#define PDCIP_CPP_MERKLE_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Pairs of corresponding nodes from two trees whose subtrees differ.
+ */
+using changed_node_vector = std::vector<std::pair<const tree*, const tree*>>;
+
+/**
+ * Stand-in hash for a `nullptr` child, e.g. a missing `binary_tree` child.
+ */
+constexpr std::uint64_t merkle_null_hash = 0x6a09e667f3bcc909ULL;
+
+/**
+ * Return the hash of a node value.
+ *
+ * `-0.0` hashes like `0.0` and every `NAN` hashes alike, matching how values
+ * are compared, except that `NAN` values are considered equal.
+ *
+ * @param value `double` node value
+ */
+inline std::uint64_t merkle_value_hash(double value)
+{
+  if (std::isnan(value)) {
+    value = NAN;
+  }
+  else if (value == 0) {
+    value = 0;
+  }
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof bits);
+  return mix_hash(bits);
+}
+
+/**
+ * Fold the hash of the next child into a node hash.
+ *
+ * The fold is order-dependent, so swapping children changes the hash.
+ *
+ * @param seed `std::uint64_t` node hash so far, starting from the value hash
+ * @param child `std::uint64_t` hash of the next child
+ */
+inline std::uint64_t merkle_combine(std::uint64_t seed, std::uint64_t child)
+{
+  return mix_hash(
+    seed ^ (child + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2))
+  );
+}
+
+/**
+ * Return `true` if two node values are equal, treating all `NAN` as equal.
+ *
+ * @param first `double` first node value
+ * @param second `double` second node value
+ */
+inline bool same_node_value(double first, double second)
+{
+  return first == second || (std::isnan(first) && std::isnan(second));
+}
+
+/**
+ * Return number of child slots of a node, including `nullptr` children.
+ *
+ * @param node `const tree&` tree node
+ */
+inline std::size_t child_slots(const tree& node)
+{
+  return node.children() ? node.n_children() : 0;
+}
+
+/**
+ * Collect the differing nodes of two trees, skipping equal-hash subtrees.
+ *
+ * Descends only into pairs of subtrees whose hashes differ. A pair is
+ * reported if the nodes differ in value or number of children, and its
+ * children are compared position by position only if the numbers of
+ * children agree. A child present on one side only is reported paired with
+ * `nullptr`. The work is proportional to the size of the changed region.
+ *
+ * @tparam first_hash_t callable with signature `std::uint64_t(const tree*)`
+ * @tparam second_hash_t callable with signature `std::uint64_t(const tree*)`
+ * @param first `const tree*` root of the first tree
+ * @param second `const tree*` root of the second tree
+ * @param first_hash `first_hash_t&&` subtree hash of a first tree node
+ * @param second_hash `second_hash_t&&` subtree hash of a second tree node
+ * @param out `changed_node_vector&` buffer the differing pairs are added to
+ */
+template <typename first_hash_t, typename second_hash_t>
+void diff_subtrees(
+  const tree* first,
+  const tree* second,
+  first_hash_t&& first_hash,
+  second_hash_t&& second_hash,
+  changed_node_vector& out)
+{
+  changed_node_vector stack{{first, second}};
+  while (!stack.empty()) {
+    auto [a, b] = stack.back();
+    stack.pop_back();
+    if (!a || !b) {
+      if (a || b) {
+        out.emplace_back(a, b);
+      }
+      continue;
+    }
+    if (first_hash(a) == second_hash(b)) {
+      continue;
+    }
+    std::size_t n_slots = child_slots(*a);
+    if (
+      !same_node_value(a->value(), b->value()) || n_slots != child_slots(*b)
+    ) {
+      out.emplace_back(a, b);
+    }
+    if (n_slots != child_slots(*b)) {
+      continue;
+    }
+    for (std::size_t i = n_slots; i-- > 0; ) {
+      stack.emplace_back((*a->children())[i].get(), (*b->children())[i].get());
+    }
+  }
+}
+
+/**
+ * Merkle hashes of every subtree of a `tree`, computed in one pass.
+ *
+ * Each node's hash folds its value hash with its children's hashes in
+ * order, so equal hashes mean, with overwhelming probability, equal
+ * subtrees. Two trees can then be compared in `O(1)` by their root hashes
+ * and diffed in time proportional to what changed.
+ *
+ * @note The hashes are a snapshot. A plain `tree` has no parent pointers to
+ *    invalidate through, so the hashes must be rebuilt after the tree is
+ *    changed. `augmented_tree::hash` instead caches hashes in the nodes and
+ *    invalidates them on mutation.
+ */
+class merkle_hashes {
+public:
+  merkle_hashes(const tree_ptr&);
+  const tree_ptr& root() const;
+  std::size_t size() const;
+  std::uint64_t root_hash() const;
+  std::uint64_t hash(const tree*) const;
+  changed_node_vector diff(const merkle_hashes&) const;
+private:
+  tree_ptr root_;
+  flat_hash_map<std::uint64_t> hashes_;
+};
+
+bool operator==(const merkle_hashes&, const merkle_hashes&);
+bool operator!=(const merkle_hashes&, const merkle_hashes&);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_MERKLE_H_
@@ -0,0 +1,36 @@
+/**
+ * @file mst.h
+ * @author Derek Huang
+ * @brief C++ header for minimum spanning tree/forest algorithms
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_MST_H_
+#define PDCIP_CPP_MST_H_
+
+#include <cstddef>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Minimum spanning forest given as `csr_graph` edge indices.
+ *
+ * Each undirected edge is reported through its `(u, v)` direction with
+ * `u < v`, so an edge index `e` can be mapped back to its endpoints with the
+ * source row and `csr_graph::target(e)`.
+ */
+struct spanning_forest {
+  edge_index_vector edges;
+  double total_weight;
+};
+
+spanning_forest kruskal_mst(const csr_graph&, std::size_t = 0);
+spanning_forest prim_mst(const csr_graph&);
+spanning_forest boruvka_mst(const csr_graph&, std::size_t = 0);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_MST_H_
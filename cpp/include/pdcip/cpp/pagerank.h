@@ -0,0 +1,54 @@
+/**
+ * @file pagerank.h
+ * @author Derek Huang
+ * @brief C++ header for PageRank and personalized PageRank
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_PAGERANK_H_
+#define PDCIP_CPP_PAGERANK_H_
+
+#include <cstddef>
+
+#include "pdcip/cpp/compressed_graph.h"
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Pull-based PageRank power iteration over a directed graph.
+ *
+ * The transpose of the graph and the inverse out-degrees are built once on
+ * construction, after which each `solve` call only touches the caller's rank
+ * vector plus two preallocated work arrays, so repeated solves (e.g. with
+ * different teleport vectors) do not allocate. Dangling vertices, i.e. those
+ * without out-edges, have their rank redistributed along the teleport vector.
+ *
+ * @note Edge weights are ignored; parallel edges count multiple times.
+ */
+class pagerank {
+public:
+  pagerank(const csr_graph&, double = 0.85, std::size_t = 0);
+  pagerank(const compressed_graph&, double = 0.85, std::size_t = 0);
+  std::size_t n_vertices() const;
+  double damping() const;
+  std::size_t solve(double_vector&, double = 1e-10, std::size_t = 100);
+  std::size_t solve(
+    double_vector&, const double_vector&, double = 1e-10, std::size_t = 100
+  );
+private:
+  pagerank(csr_graph&&, double_vector&&, double, std::size_t);
+  std::size_t iterate(double_vector&, double, std::size_t);
+  csr_graph in_edges_;
+  double_vector inv_out_degrees_;
+  double_vector contribs_;
+  double_vector next_ranks_;
+  double_vector teleport_;
+  double damping_;
+  std::size_t n_threads_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_PAGERANK_H_
@@ -0,0 +1,162 @@
+/**
+ * @file parallel.h
+ * @author Derek Huang
+ * @brief C++ header for simple thread-based parallel loop helpers
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_PARALLEL_H_
+#define PDCIP_CPP_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace pdcip {
+
+std::size_t default_n_threads();
+
+/**
+ * Resolve a requested thread count, where `0` means "use the default".
+ *
+ * @param n_threads `std::size_t` requested number of threads
+ */
+inline std::size_t resolve_n_threads(std::size_t n_threads)
+{
+  return (n_threads) ? n_threads : default_n_threads();
+}
+
+/**
+ * Run `func(thread_id)` on `n_threads` threads and wait for all to finish.
+ *
+ * The calling thread participates as thread `0`, so only `n_threads - 1` new
+ * threads are actually spawned. Useful when each thread needs its own
+ * accumulator that is later reduced by the caller.
+ *
+ * @tparam F callable with signature `void(std::size_t)`
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @param func `F&&` callable invoked once per thread with the thread index
+ */
+template <typename F>
+void parallel_run(std::size_t n_threads, F&& func)
+{
+  n_threads = resolve_n_threads(n_threads);
+  std::vector<std::thread> workers;
+  workers.reserve(n_threads - 1);
+  for (std::size_t i = 1; i < n_threads; i++) {
+    workers.emplace_back([&func, i] { func(i); });
+  }
+  func(0);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+/**
+ * Split `[0, n)` into chunks processed by `n_threads` threads.
+ *
+ * Chunks of `grain` indices are handed out dynamically through an atomic
+ * counter, which keeps threads balanced on skewed inputs like power-law
+ * graphs. Runs inline on the calling thread if there is only one chunk.
+ *
+ * @tparam F callable with signature `void(std::size_t, std::size_t,
+ *    std::size_t)` taking the chunk begin, chunk end, and thread index
+ * @param n `std::size_t` number of indices to process
+ * @param func `F&&` callable invoked on each chunk
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @param grain `std::size_t` number of indices per chunk
+ */
+template <typename F>
+void parallel_for(
+  std::size_t n, F&& func, std::size_t n_threads = 0, std::size_t grain = 1024)
+{
+  if (!n) {
+    return;
+  }
+  grain = std::max<std::size_t>(grain, 1);
+  std::size_t n_chunks = (n + grain - 1) / grain;
+  n_threads = std::min(resolve_n_threads(n_threads), n_chunks);
+  if (n_threads == 1) {
+    func(std::size_t(0), n, std::size_t(0));
+    return;
+  }
+  std::atomic<std::size_t> next_chunk(0);
+  parallel_run(
+    n_threads,
+    [&](std::size_t thread_id)
+    {
+      for (
+        std::size_t chunk = next_chunk.fetch_add(1);
+        chunk < n_chunks;
+        chunk = next_chunk.fetch_add(1)
+      ) {
+        std::size_t begin = chunk * grain;
+        func(begin, std::min(begin + grain, n), thread_id);
+      }
+    }
+  );
+}
+
+/**
+ * Sort a random access range on multiple threads.
+ *
+ * The range is split into one block per thread, blocks are sorted
+ * concurrently with `std::sort`, and then adjacent blocks are merged pairwise
+ * in `log2(n_threads)` parallel rounds. Small ranges are sorted inline.
+ *
+ * @tparam It random access iterator type
+ * @tparam Compare strict weak ordering on the iterator value type
+ * @param first `It` start of range to sort
+ * @param last `It` end of range to sort
+ * @param comp `Compare` comparison function
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+template <typename It, typename Compare>
+void parallel_sort(It first, It last, Compare comp, std::size_t n_threads = 0)
+{
+  // below this many elements per block threading costs more than it saves
+  constexpr std::size_t min_block = 1 << 14;
+  auto n = static_cast<std::size_t>(last - first);
+  n_threads = std::min(
+    resolve_n_threads(n_threads), std::max<std::size_t>(n / min_block, 1)
+  );
+  if (n_threads == 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+  std::vector<std::size_t> bounds(n_threads + 1);
+  for (std::size_t i = 0; i <= n_threads; i++) {
+    bounds[i] = i * n / n_threads;
+  }
+  parallel_run(
+    n_threads,
+    [&](std::size_t i)
+    {
+      std::sort(first + bounds[i], first + bounds[i + 1], comp);
+    }
+  );
+  for (std::size_t width = 1; width < n_threads; width *= 2) {
+    parallel_for(
+      (n_threads + 2 * width - 1) / (2 * width),
+      [&](std::size_t begin, std::size_t end, std::size_t)
+      {
+        for (std::size_t pair = begin; pair < end; pair++) {
+          std::size_t lo = pair * 2 * width;
+          std::size_t mid = std::min(lo + width, n_threads);
+          std::size_t hi = std::min(lo + 2 * width, n_threads);
+          std::inplace_merge(
+            first + bounds[lo], first + bounds[mid], first + bounds[hi], comp
+          );
+        }
+      },
+      n_threads,
+      1
+    );
+  }
+}
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_PARALLEL_H_
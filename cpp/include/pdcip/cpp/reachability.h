@@ -0,0 +1,69 @@
+/**
+ * @file reachability.h
+ * @author Derek Huang
+ * @brief C++ header for a DAG reachability index
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_REACHABILITY_H_
+#define PDCIP_CPP_REACHABILITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Index answering whether one vertex of a DAG can reach another.
+ *
+ * Most queries are settled in constant time by a chain of cheap labels:
+ *
+ * - Topological levels rule out `u` reaching `v` unless `u` is on an
+ *   earlier level.
+ * - Depth-first post-order intervals, where every vertex `u` reaches lies in
+ *   `[low(u), post(u)]`, rule out vertices outside the interval, and
+ *   pre-order intervals of the DFS spanning forest confirm tree descendants.
+ * - `64 * n_words` landmark vertices of high degree are propagated as
+ *   bitsets, 64 sources per word, level by level in parallel. `u` reaches
+ *   `v` if a landmark reachable from `u` reaches `v`, and cannot if `v`
+ *   reaches a landmark that `u` does not.
+ *
+ * Queries the labels cannot settle fall back to a depth-first search from
+ * `u` that prunes every vertex the labels rule out, so answers are exact.
+ *
+ * @note To index a `graph`, first convert it with the `csr_graph` constructor
+ *    taking vertices and edges.
+ */
+class reachability_index {
+public:
+  reachability_index(const csr_graph&, std::size_t = 1, std::size_t = 0);
+  std::size_t n_vertices() const;
+  std::size_t n_landmarks() const;
+  bool reachable(vertex_index, vertex_index) const;
+  std::vector<std::uint8_t> reachable(
+    const vertex_index_vector&, const vertex_index_vector&, std::size_t = 0
+  ) const;
+private:
+  std::optional<bool> label_check(vertex_index, vertex_index) const;
+  const std::uint64_t* out_bits(vertex_index) const;
+  const std::uint64_t* in_bits(vertex_index) const;
+  csr_graph graph_;
+  std::size_t n_words_;
+  std::size_t n_landmarks_;
+  vertex_index_vector levels_;
+  vertex_index_vector pre_;
+  vertex_index_vector pre_end_;
+  vertex_index_vector post_;
+  vertex_index_vector low_;
+  std::vector<std::uint64_t> out_bits_;
+  std::vector<std::uint64_t> in_bits_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_REACHABILITY_H_
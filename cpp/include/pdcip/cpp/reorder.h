@@ -0,0 +1,27 @@
+/**
+ * @file reorder.h
+ * @author Derek Huang
+ * @brief C++ header for cache-aware vertex reordering
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_REORDER_H_
+#define PDCIP_CPP_REORDER_H_
+
+#include <cstddef>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+vertex_index_vector reverse_cuthill_mckee(const csr_graph&);
+vertex_index_vector degree_ordering(const csr_graph&, std::size_t = 0);
+vertex_index_vector gorder(const csr_graph&, std::size_t = 5);
+csr_graph permute_vertices(
+  const csr_graph&, const vertex_index_vector&, std::size_t = 0
+);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_REORDER_H_
@@ -0,0 +1,68 @@
+/**
+ * @file segment_tree.h
+ * @author Derek Huang
+ * @brief C++ header for a lazy propagation segment tree
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_SEGMENT_TREE_H_
+#define PDCIP_CPP_SEGMENT_TREE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Segment tree over a `double_vector` with range updates and range queries.
+ *
+ * Supports adding to or assigning every value in a range and taking the sum,
+ * minimum, or maximum of a range, each in `O(log n)`. Nodes live in one flat
+ * array with the leaves padded to a power of two, node `i` having children
+ * `2i` and `2i + 1`, and everything is iterative and bottom-up: updates
+ * first push pending tags down the two root-to-boundary paths, tag the
+ * `O(log n)` nodes covering the range, then recompute the two paths.
+ *
+ * @note Queries also push pending tags down, so they are not `const`.
+ */
+class segment_tree {
+public:
+  segment_tree(const double_vector& = double_vector());
+  std::size_t size() const;
+  void add(std::size_t, std::size_t, double);
+  void assign(std::size_t, std::size_t, double);
+  double sum(std::size_t, std::size_t);
+  double min(std::size_t, std::size_t);
+  double max(std::size_t, std::size_t);
+  double value(std::size_t);
+  double_vector values();
+private:
+  /**
+   * Aggregates of a node's range and the update pending for its children.
+   */
+  struct node {
+    double sum;
+    double min;
+    double max;
+    double add;
+    double assign;
+    bool assigned;
+  };
+
+  void apply_add(std::size_t, double, std::size_t);
+  void apply_assign(std::size_t, double, std::size_t);
+  void push(std::size_t);
+  void push_node(std::size_t, std::size_t);
+  void rebuild(std::size_t, std::size_t);
+  void rebuild_path(std::size_t);
+  node query(std::size_t, std::size_t);
+  std::size_t n_values_;
+  std::size_t height_;
+  std::vector<node> nodes_;
+};
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_SEGMENT_TREE_H_
@@ -0,0 +1,66 @@
+/**
+ * @file snapshot.h
+ * @author Derek Huang
+ * @brief C++ header for memory-mapped binary graph snapshots
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_SNAPSHOT_H_
+#define PDCIP_CPP_SNAPSHOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "pdcip/cpp/compressed_graph.h"
+#include "pdcip/cpp/csr_graph.h"
+
+namespace pdcip {
+
+/**
+ * Current version of the binary snapshot format.
+ */
+constexpr std::uint32_t snapshot_version = 1;
+
+/**
+ * Fixed-size header at the start of a binary graph snapshot.
+ *
+ * The `*_pos` members are byte offsets of each array from the start of the
+ * file, each aligned to `snapshot_alignment`, with `weights_pos` zero for an
+ * unweighted graph. `byte_order` holds `0x01020304` as written by the
+ * producing machine, so files from a machine of the other endianness are
+ * rejected rather than misread.
+ */
+struct snapshot_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t edge_index_size;
+  std::uint32_t vertex_index_size;
+  std::uint64_t n_vertices;
+  std::uint64_t n_edges;
+  std::uint64_t offsets_pos;
+  std::uint64_t targets_pos;
+  std::uint64_t weights_pos;
+  std::uint64_t values_pos;
+  std::uint64_t file_size;
+  std::uint64_t reserved[6];
+};
+
+/**
+ * Alignment of the header and every array in a snapshot file.
+ */
+constexpr std::uint64_t snapshot_alignment = 64;
+
+static_assert(sizeof(snapshot_header) % snapshot_alignment == 0);
+
+bool write_snapshot(const csr_graph&, const std::string&);
+std::optional<csr_graph> open_snapshot(const std::string&);
+std::optional<compressed_graph> open_compressed_snapshot(
+  const std::string&, std::size_t = 0
+);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_SNAPSHOT_H_
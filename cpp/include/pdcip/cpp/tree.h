@@ -10,6 +10,7 @@
 
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <vector>
@@ -79,6 +80,19 @@ T_ptr_vector_ptr_t<tree_t> make_tree_ptr_vector(const double_vector& values)
   return children;
 }
 
+/**
+ * Return the key of a tree node in a `flat_hash_map`, i.e. its address.
+ *
+ * Indexes built over a tree, e.g. `lca_index` or `merkle_hashes`, map nodes
+ * to their data with this key, so a node can't be shared within a tree.
+ *
+ * @param node `const tree*` tree node
+ */
+inline std::uint64_t node_key(const tree* node)
+{
+  return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(node));
+}
+
 }  // namespace pdcip
 
 #endif  // PDCIP_CPP_TREE_H_
@@ -0,0 +1,65 @@
+/**
+ * @file tree_diff.h
+ * @author Derek Huang
+ * @brief C++ header for diffing and patching trees
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_TREE_DIFF_H_
+#define PDCIP_CPP_TREE_DIFF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Single edit of a tree patch.
+ *
+ * Nodes of the source tree are numbered by their position in `tree::dfs` of
+ * the source, and inserted nodes are numbered on from there in the order of
+ * their `insert` edits. `parent` and `position` give where an inserted or
+ * moved node ends up among the children of its parent in the patched tree,
+ * and `value` is the value of an inserted or updated node. Unused fields are
+ * zero.
+ */
+struct tree_edit {
+  tree_edit_type type;
+  vertex_index node;
+  vertex_index parent;
+  vertex_index position;
+  double value;
+};
+
+/**
+ * Edit script turning a source tree into a target tree.
+ *
+ * The source and target root hashes are those of `merkle_hashes`, so a
+ * replica can check that it holds the source before patching and that it
+ * holds the target after.
+ *
+ * Patches only apply to trees made of plain `tree` nodes. Inserted nodes are
+ * always created as `tree`, and updates call `tree::set_value`, so trees of
+ * subclasses such as `augmented_tree` or `binary_tree` are refused rather
+ * than given nodes of the wrong type or stale augmented values. Trees with
+ * `nullptr` children, such as a `binary_tree` missing a child, cannot be
+ * diffed or patched at all.
+ */
+struct tree_patch {
+  std::size_t source_size;
+  std::uint64_t source_hash;
+  std::uint64_t target_hash;
+  std::vector<tree_edit> edits;
+};
+
+tree_patch diff_trees(const tree_ptr&, const tree_ptr&);
+bool apply_tree_patch(const tree_ptr&, const tree_patch&);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_TREE_DIFF_H_
@@ -0,0 +1,37 @@
+/**
+ * @file triangles.h
+ * @author Derek Huang
+ * @brief C++ header for triangle counting and clustering coefficients
+ * @copyright MIT License
+ */
+
+#ifndef PDCIP_CPP_TRIANGLES_H_
+#define PDCIP_CPP_TRIANGLES_H_
+
+#include <cstddef>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Per-vertex triangle counts and local clustering coefficients.
+ *
+ * `vertex_triangles[v]` is the number of triangles containing `v` and
+ * `clustering[v]` is the fraction of pairs of neighbors of `v` that are
+ * themselves adjacent, `0` for vertices with fewer than two neighbors.
+ */
+struct triangle_stats {
+  std::size_t n_triangles;
+  edge_index_vector vertex_triangles;
+  double_vector clustering;
+};
+
+csr_graph degree_orient(const csr_graph&, std::size_t = 0);
+std::size_t count_triangles(const csr_graph&, std::size_t = 0);
+triangle_stats local_clustering(const csr_graph&, std::size_t = 0);
+
+}  // namespace pdcip
+
+#endif  // PDCIP_CPP_TRIANGLES_H_
@@ -8,6 +8,8 @@
 #ifndef PDCIP_CPP_TYPES_H_
 #define PDCIP_CPP_TYPES_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -48,6 +50,17 @@ using edge_ptr = T_ptr_t<edge>;
 using edge_ptr_vector = T_ptr_vector_t<edge>;
 using edge_ptr_vector_ptr = T_ptr_vector_ptr_t<edge>;
 
+// compact integer indices used by the array-based graph representations
+using vertex_index = std::uint32_t;
+using vertex_index_vector = std::vector<vertex_index>;
+using vertex_index_vector_ptr = vector_ptr_t<vertex_index>;
+using edge_index = std::size_t;
+using edge_index_vector = std::vector<edge_index>;
+using edge_index_vector_ptr = vector_ptr_t<edge_index>;
+
+class csr_graph;
+using csr_graph_ptr = T_ptr_t<csr_graph>;
+
 class single_link;
 using single_link_ptr = T_ptr_t<single_link>;
 
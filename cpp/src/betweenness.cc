@@ -0,0 +1,280 @@
+/**
+ * @file betweenness.cc
+ * @author Derek Huang
+ * @brief C++ source for betweenness centrality
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/betweenness.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/indexed_heap.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Per-thread scratch space and score accumulator for Brandes' algorithm.
+ *
+ * Arrays are sized to the graph once and only the entries touched by a
+ * single-source pass are reset afterwards, so sources that reach few
+ * vertices stay cheap.
+ */
+class brandes_worker {
+public:
+  /**
+   * `brandes_worker` constructor.
+   *
+   * @param graph `const csr_graph&` graph to compute betweenness on
+   */
+  brandes_worker(const csr_graph& graph)
+    : graph_(graph),
+      dists_(graph.n_vertices(), std::numeric_limits<double>::infinity()),
+      sigmas_(graph.n_vertices(), 0),
+      deltas_(graph.n_vertices(), 0),
+      scores_(graph.n_vertices(), 0),
+      heap_((graph.weighted()) ? graph.n_vertices() : 0)
+  {}
+
+  /**
+   * Add the dependencies of all vertices on one source to the scores.
+   *
+   * @param source `vertex_index` source vertex
+   */
+  void accumulate(vertex_index source)
+  {
+    if (graph_.weighted()) {
+      dijkstra(source);
+    }
+    else {
+      bfs(source);
+    }
+    // vertices in nonincreasing distance, so successors are done first
+    for (auto it = order_.rbegin(); it != order_.rend(); it++) {
+      vertex_index v = *it;
+      graph_.for_each_neighbor(
+        v,
+        [&](vertex_index w, edge_index e)
+        {
+          if (dists_[w] == dists_[v] + graph_.weight(e) && sigmas_[w] > 0) {
+            deltas_[v] += sigmas_[v] / sigmas_[w] * (1 + deltas_[w]);
+          }
+        }
+      );
+      if (v != source) {
+        scores_[v] += deltas_[v];
+      }
+    }
+    for (vertex_index v : order_) {
+      dists_[v] = std::numeric_limits<double>::infinity();
+      sigmas_[v] = deltas_[v] = 0;
+    }
+    order_.clear();
+  }
+
+  /**
+   * Return the accumulated scores.
+   */
+  const double_vector& scores() const { return scores_; }
+
+private:
+  /**
+   * Count shortest paths from `source` with a breadth-first search.
+   *
+   * @param source `vertex_index` source vertex
+   */
+  void bfs(vertex_index source)
+  {
+    dists_[source] = 0;
+    sigmas_[source] = 1;
+    order_.push_back(source);
+    for (std::size_t i = 0; i < order_.size(); i++) {
+      vertex_index v = order_[i];
+      graph_.for_each_neighbor(
+        v,
+        [&](vertex_index w, edge_index)
+        {
+          if (dists_[w] == std::numeric_limits<double>::infinity()) {
+            dists_[w] = dists_[v] + 1;
+            order_.push_back(w);
+          }
+          if (dists_[w] == dists_[v] + 1) {
+            sigmas_[w] += sigmas_[v];
+          }
+        }
+      );
+    }
+  }
+
+  /**
+   * Count shortest paths from `source` with Dijkstra's algorithm.
+   *
+   * @param source `vertex_index` source vertex
+   */
+  void dijkstra(vertex_index source)
+  {
+    dists_[source] = 0;
+    sigmas_[source] = 1;
+    heap_.push_or_decrease(source, 0);
+    while (!heap_.empty()) {
+      vertex_index v = heap_.pop();
+      order_.push_back(v);
+      graph_.for_each_neighbor(
+        v,
+        [&](vertex_index w, edge_index e)
+        {
+          assert(graph_.weight(e) > 0 && "weights must be positive");
+          double dist = dists_[v] + graph_.weight(e);
+          if (dist < dists_[w]) {
+            dists_[w] = dist;
+            sigmas_[w] = sigmas_[v];
+            heap_.push_or_decrease(w, dist);
+          }
+          else if (dist == dists_[w]) {
+            sigmas_[w] += sigmas_[v];
+          }
+        }
+      );
+    }
+  }
+
+  const csr_graph& graph_;
+  double_vector dists_;
+  double_vector sigmas_;
+  double_vector deltas_;
+  double_vector scores_;
+  vertex_index_vector order_;
+  indexed_heap<double> heap_;
+};
+
+/**
+ * Sum up dependencies from the given sources across threads.
+ *
+ * Sources are handed out one at a time, since the cost of a single-source
+ * pass varies wildly. Each thread accumulates into its own `brandes_worker`
+ * and the per-thread scores are summed up at the end.
+ *
+ * @param graph `const csr_graph&` graph to compute betweenness on
+ * @param sources `const vertex_index_vector&` source vertices
+ * @param scale `double` factor to multiply the summed scores by
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+double_vector brandes(
+  const csr_graph& graph,
+  const vertex_index_vector& sources,
+  double scale,
+  std::size_t n_threads)
+{
+  std::vector<std::unique_ptr<brandes_worker>> workers(
+    resolve_n_threads(n_threads)
+  );
+  parallel_for(
+    sources.size(),
+    [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+    {
+      if (!workers[thread_id]) {
+        workers[thread_id] = std::make_unique<brandes_worker>(graph);
+      }
+      for (std::size_t i = begin; i < end; i++) {
+        workers[thread_id]->accumulate(sources[i]);
+      }
+    },
+    n_threads,
+    1
+  );
+  double_vector scores(graph.n_vertices(), 0);
+  for (const std::unique_ptr<brandes_worker>& worker : workers) {
+    if (worker) {
+      for (std::size_t v = 0; v < scores.size(); v++) {
+        scores[v] += worker->scores()[v];
+      }
+    }
+  }
+  for (double& score : scores) {
+    score *= scale;
+  }
+  return scores;
+}
+
+}  // namespace
+
+/**
+ * Compute exact betweenness centrality with Brandes' algorithm.
+ *
+ * Runs a single-source shortest path count from every vertex, breadth-first
+ * if the graph is unweighted and with Dijkstra's algorithm otherwise, then
+ * accumulates dependencies backwards. Sources are spread over threads, giving
+ * `O(VE / n_threads)` time for unweighted graphs.
+ *
+ * @note Paths follow edge direction. For undirected graphs given in symmetric
+ *    form, every path is counted from both ends, so halve the scores to get
+ *    the usual undirected values.
+ *
+ * @param graph `const csr_graph&` graph, with positive weights if weighted
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `double_vector` with the betweenness of each vertex
+ */
+double_vector betweenness_centrality(
+  const csr_graph& graph, std::size_t n_threads)
+{
+  vertex_index_vector sources(graph.n_vertices());
+  for (std::size_t v = 0; v < sources.size(); v++) {
+    sources[v] = static_cast<vertex_index>(v);
+  }
+  return brandes(graph, sources, 1, n_threads);
+}
+
+/**
+ * Estimate betweenness centrality from a uniform sample of sources.
+ *
+ * Runs Brandes' algorithm from `n_samples` distinct random sources and
+ * scales the scores by `n_vertices / n_samples`, which gives an unbiased
+ * estimate of the exact scores at a fraction of the cost.
+ *
+ * @param graph `const csr_graph&` graph, with positive weights if weighted
+ * @param n_samples `std::size_t` number of sources, capped at `n_vertices`
+ * @param seed `std::uint64_t` random seed for picking sources
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `double_vector` with the estimated betweenness of each vertex
+ */
+double_vector approximate_betweenness(
+  const csr_graph& graph,
+  std::size_t n_samples,
+  std::uint64_t seed,
+  std::size_t n_threads)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  n_samples = std::min(n_samples, n_vertices);
+  if (!n_samples) {
+    return double_vector(n_vertices, 0);
+  }
+  // partial Fisher-Yates shuffle picks n_samples distinct sources
+  vertex_index_vector sources(n_vertices);
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    sources[v] = static_cast<vertex_index>(v);
+  }
+  std::mt19937_64 rng(seed);
+  for (std::size_t i = 0; i < n_samples; i++) {
+    std::uniform_int_distribution<std::size_t> dist(i, n_vertices - 1);
+    std::swap(sources[i], sources[dist(rng)]);
+  }
+  sources.resize(n_samples);
+  return brandes(
+    graph, sources, static_cast<double>(n_vertices) / n_samples, n_threads
+  );
+}
+
+}  // namespace pdcip
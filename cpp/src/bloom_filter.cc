@@ -0,0 +1,56 @@
+/**
+ * @file bloom_filter.cc
+ * @author Derek Huang
+ * @brief C++ source for a cache-line blocked Bloom filter
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/bloom_filter.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+namespace pdcip {
+
+/**
+ * `blocked_bloom_filter` constructor.
+ *
+ * @param n_keys `std::size_t` expected number of keys
+ * @param bits_per_key `double` bits of filter per expected key, where more
+ *    bits give fewer false positives
+ */
+blocked_bloom_filter::blocked_bloom_filter(
+  std::size_t n_keys, double bits_per_key)
+{
+  assert(bits_per_key > 0);
+  auto n_blocks = static_cast<std::size_t>(
+    std::ceil(n_keys * bits_per_key / (64 * block_words))
+  );
+  blocks_.resize(n_blocks ? n_blocks : 1, block{});
+}
+
+/**
+ * Return number of 64-byte blocks in the filter.
+ */
+std::size_t blocked_bloom_filter::n_blocks() const { return blocks_.size(); }
+
+/**
+ * Return size of the filter's bit array in bytes.
+ */
+std::size_t blocked_bloom_filter::n_bytes() const
+{
+  return blocks_.size() * sizeof(block);
+}
+
+/**
+ * Remove all keys, keeping the size.
+ */
+void blocked_bloom_filter::clear()
+{
+  for (block& target : blocks_) {
+    target = block{};
+  }
+}
+
+}  // namespace pdcip
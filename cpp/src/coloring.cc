@@ -0,0 +1,303 @@
+/**
+ * @file coloring.cc
+ * @author Derek Huang
+ * @brief C++ source for graph coloring
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/coloring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/kcore.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Color value for vertices that have not been colored yet.
+ */
+constexpr vertex_index no_color = std::numeric_limits<vertex_index>::max();
+
+/**
+ * Return the largest vertex degree of a graph.
+ *
+ * @param graph `const csr_graph&` graph
+ */
+vertex_index max_degree(const csr_graph& graph)
+{
+  std::size_t result = 0;
+  for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+    result = std::max(result, graph.degree(v));
+  }
+  return static_cast<vertex_index>(result);
+}
+
+/**
+ * Smallest color not used by any neighbor of a vertex.
+ *
+ * Holds a per-color stamp instead of a set of booleans, so marking colors for
+ * a new vertex does not require clearing the marks of the previous one. Each
+ * call stamps with a fresh generation rather than the vertex, since
+ * `parallel_coloring` may recolor the same vertex with the same `first_fit`
+ * in a later round, where marks left over from the earlier round would block
+ * free colors and could fill every slot.
+ */
+class first_fit {
+public:
+  /**
+   * `first_fit` constructor.
+   *
+   * @param max_degree `vertex_index` largest vertex degree of the graph
+   */
+  first_fit(vertex_index max_degree)
+    : stamps_(max_degree + 1, 0), generation_(0)
+  {}
+
+  /**
+   * Return the smallest color not in use by neighbors of a vertex.
+   *
+   * @param graph `const csr_graph&` graph being colored
+   * @param v `vertex_index` vertex to color
+   * @param color_of `const color_func&` callable returning a vertex's color
+   */
+  template <typename color_func>
+  vertex_index operator()(
+    const csr_graph& graph, vertex_index v, const color_func& color_of)
+  {
+    generation_++;
+    graph.for_each_neighbor(
+      v,
+      [&](vertex_index u, edge_index)
+      {
+        vertex_index color = color_of(u);
+        // a vertex can't see more than degree colors, so larger ones never
+        // block the smallest free color
+        if (u != v && color < stamps_.size()) {
+          stamps_[color] = generation_;
+        }
+      }
+    );
+    vertex_index color = 0;
+    while (stamps_[color] == generation_) {
+      color++;
+    }
+    return color;
+  }
+
+private:
+  std::vector<std::uint64_t> stamps_;
+  std::uint64_t generation_;
+};
+
+/**
+ * Return the number of colors used, i.e. one past the largest color.
+ *
+ * @param colors `const vertex_index_vector&` color of each vertex
+ */
+std::size_t count_colors(const vertex_index_vector& colors)
+{
+  std::size_t n_colors = 0;
+  for (vertex_index color : colors) {
+    n_colors = std::max<std::size_t>(n_colors, color + 1);
+  }
+  return n_colors;
+}
+
+}  // namespace
+
+/**
+ * Return the order in which greedy coloring visits vertices.
+ *
+ * `largest_first` is a counting sort by degree. `smallest_last` is the
+ * reverse of the removal order of `peel_by_degree`, a degeneracy ordering
+ * found in `O(V + E)`, which guarantees at most `d + 1` colors for a
+ * `d`-degenerate graph, e.g. at most 6 colors for planar graphs.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *
+ * @param graph `const csr_graph&` undirected graph
+ * @param order `coloring_order` vertex ordering to use
+ */
+vertex_index_vector coloring_sequence(
+  const csr_graph& graph, coloring_order order)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  vertex_index_vector sequence(n_vertices);
+  if (order == coloring_order::natural) {
+    for (std::size_t v = 0; v < n_vertices; v++) {
+      sequence[v] = static_cast<vertex_index>(v);
+    }
+    return sequence;
+  }
+  if (order == coloring_order::smallest_last) {
+    sequence = peel_by_degree(graph).order;
+    std::reverse(sequence.begin(), sequence.end());
+    return sequence;
+  }
+  vertex_index_vector degrees(n_vertices);
+  vertex_index top_degree = 0;
+  for (vertex_index v = 0; v < n_vertices; v++) {
+    degrees[v] = static_cast<vertex_index>(
+      graph.degree(v) - graph.has_edge(v, v)
+    );
+    top_degree = std::max(top_degree, degrees[v]);
+  }
+  // counting sort by decreasing degree
+  vertex_index_vector starts(top_degree + 2, 0);
+  for (vertex_index degree : degrees) {
+    starts[top_degree - degree + 1]++;
+  }
+  for (std::size_t d = 0; d <= top_degree; d++) {
+    starts[d + 1] += starts[d];
+  }
+  for (vertex_index v = 0; v < n_vertices; v++) {
+    sequence[starts[top_degree - degrees[v]]++] = v;
+  }
+  return sequence;
+}
+
+/**
+ * Color a graph greedily, giving each vertex the smallest free color.
+ *
+ * Vertices are visited in the given `order`, and each takes the smallest
+ * color not used by an already colored neighbor, so at most
+ * `max_degree + 1` colors are used. Runs in `O(V + E)`.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *    Self-loops are ignored.
+ *
+ * @param graph `const csr_graph&` undirected graph
+ * @param order `coloring_order` vertex ordering to use
+ */
+vertex_coloring greedy_coloring(const csr_graph& graph, coloring_order order)
+{
+  vertex_index_vector colors(graph.n_vertices(), no_color);
+  first_fit fit(max_degree(graph));
+  for (vertex_index v : coloring_sequence(graph, order)) {
+    colors[v] = fit(graph, v, [&](vertex_index u) { return colors[u]; });
+  }
+  return {count_colors(colors), std::move(colors)};
+}
+
+/**
+ * Color a graph in parallel with speculative Gebremedhin-Manne rounds.
+ *
+ * Each round colors every vertex of the work list concurrently with first
+ * fit, reading neighbor colors without synchronization, so two adjacent
+ * vertices colored at the same time may pick the same color. A second
+ * parallel pass finds such conflicts and puts the larger-indexed endpoint
+ * back on the work list for the next round. Conflicts are rare when the
+ * graph is much larger than the thread count, so few rounds are needed, and
+ * the number of colors stays close to that of sequential first fit.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *    Self-loops are ignored.
+ *
+ * @param graph `const csr_graph&` undirected graph
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+vertex_coloring parallel_coloring(const csr_graph& graph, std::size_t n_threads)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  std::size_t max_threads = resolve_n_threads(n_threads);
+  vertex_index top_degree = max_degree(graph);
+  std::vector<std::atomic<vertex_index>> colors(n_vertices);
+  for (std::atomic<vertex_index>& color : colors) {
+    color.store(no_color, std::memory_order_relaxed);
+  }
+  auto color_of = [&](vertex_index u)
+  {
+    return colors[u].load(std::memory_order_relaxed);
+  };
+  vertex_index_vector work(n_vertices);
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    work[v] = static_cast<vertex_index>(v);
+  }
+  std::vector<first_fit> fits(max_threads, first_fit(top_degree));
+  std::vector<vertex_index_vector> conflicts(max_threads);
+  while (!work.empty()) {
+    parallel_for(
+      work.size(),
+      [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+      {
+        for (std::size_t i = begin; i < end; i++) {
+          colors[work[i]].store(
+            fits[thread_id](graph, work[i], color_of),
+            std::memory_order_relaxed
+          );
+        }
+      },
+      n_threads
+    );
+    parallel_for(
+      work.size(),
+      [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+      {
+        for (std::size_t i = begin; i < end; i++) {
+          vertex_index v = work[i];
+          vertex_index color = color_of(v);
+          bool conflict = false;
+          graph.for_each_neighbor(
+            v,
+            [&](vertex_index u, edge_index)
+            {
+              conflict |= (u < v && color_of(u) == color);
+            }
+          );
+          if (conflict) {
+            conflicts[thread_id].push_back(v);
+          }
+        }
+      },
+      n_threads
+    );
+    work.clear();
+    for (vertex_index_vector& buffer : conflicts) {
+      work.insert(work.end(), buffer.begin(), buffer.end());
+      buffer.clear();
+    }
+  }
+  vertex_index_vector result(n_vertices);
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    result[v] = colors[v].load(std::memory_order_relaxed);
+  }
+  return {count_colors(result), std::move(result)};
+}
+
+/**
+ * Check that no edge joins two vertices of the same color.
+ *
+ * Self-loops are ignored.
+ *
+ * @param graph `const csr_graph&` graph
+ * @param colors `const vertex_index_vector&` color of each vertex
+ */
+bool valid_coloring(const csr_graph& graph, const vertex_index_vector& colors)
+{
+  if (colors.size() != graph.n_vertices()) {
+    return false;
+  }
+  for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+    for (edge_index e = graph.edges_begin(v); e < graph.edges_end(v); e++) {
+      vertex_index u = graph.target(e);
+      if (u != v && colors[u] == colors[v]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace pdcip
@@ -0,0 +1,394 @@
+/**
+ * @file community.cc
+ * @author Derek Huang
+ * @brief C++ source for community detection algorithms
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/community.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Sparse accumulator of weights keyed by community label.
+ *
+ * Backed by a dense array plus a list of touched labels, so adding and
+ * clearing cost time proportional to the number of distinct labels seen.
+ */
+class label_weights {
+public:
+  /**
+   * `label_weights` constructor.
+   *
+   * @param n_labels `std::size_t` one past the largest label
+   */
+  label_weights(std::size_t n_labels) : weights_(n_labels, 0), seen_(n_labels)
+  {}
+
+  /**
+   * Add weight to a label.
+   *
+   * @param label `vertex_index` label to add weight to
+   * @param weight `double` weight to add
+   */
+  void add(vertex_index label, double weight)
+  {
+    if (!seen_[label]) {
+      seen_[label] = true;
+      labels_.push_back(label);
+    }
+    weights_[label] += weight;
+  }
+
+  /**
+   * Return the labels that have been added to since the last `clear`.
+   */
+  const vertex_index_vector& labels() const { return labels_; }
+
+  /**
+   * Return the weight accumulated for a label.
+   *
+   * @param label `vertex_index` label to get weight of
+   */
+  double weight(vertex_index label) const { return weights_[label]; }
+
+  /**
+   * Reset all touched labels.
+   */
+  void clear()
+  {
+    for (vertex_index label : labels_) {
+      weights_[label] = 0;
+      seen_[label] = false;
+    }
+    labels_.clear();
+  }
+
+private:
+  double_vector weights_;
+  std::vector<bool> seen_;
+  vertex_index_vector labels_;
+};
+
+/**
+ * Relabel communities to `[0, n_communities)` in order of first appearance.
+ *
+ * @param labels `vertex_index_vector&&` raw community labels
+ */
+community_assignment compact_labels(vertex_index_vector&& labels)
+{
+  constexpr vertex_index unset = std::numeric_limits<vertex_index>::max();
+  vertex_index_vector renumber(labels.size(), unset);
+  vertex_index n_communities = 0;
+  for (vertex_index& label : labels) {
+    if (renumber[label] == unset) {
+      renumber[label] = n_communities++;
+    }
+    label = renumber[label];
+  }
+  return {n_communities, std::move(labels)};
+}
+
+/**
+ * Contract each community into a single vertex.
+ *
+ * Arc weights between communities are summed, and arcs inside a community
+ * become a self-loop carrying their total, which keeps every vertex's
+ * weighted degree equal to the sum over its members.
+ *
+ * @param graph `const csr_graph&` symmetric weighted graph
+ * @param communities `const community_assignment&` compacted communities
+ */
+csr_graph coarsen(
+  const csr_graph& graph, const community_assignment& communities)
+{
+  vertex_index_vector sources = graph.edge_sources();
+  vertex_index_vector targets(graph.n_edges());
+  double_vector weights(graph.n_edges());
+  for (edge_index e = 0; e < graph.n_edges(); e++) {
+    sources[e] = communities.labels[sources[e]];
+    targets[e] = communities.labels[graph.target(e)];
+    weights[e] = graph.weight(e);
+  }
+  csr_graph merged(communities.n_communities, sources, targets, weights);
+  // rows are sorted by target, so parallel arcs are adjacent
+  edge_index_vector offsets(communities.n_communities + 1, 0);
+  targets.clear();
+  weights.clear();
+  for (vertex_index c = 0; c < communities.n_communities; c++) {
+    for (edge_index e = merged.edges_begin(c); e < merged.edges_end(c); e++) {
+      if (
+        targets.size() > offsets[c] && targets.back() == merged.target(e)
+      ) {
+        weights.back() += merged.weight(e);
+      }
+      else {
+        targets.push_back(merged.target(e));
+        weights.push_back(merged.weight(e));
+      }
+    }
+    offsets[c + 1] = targets.size();
+  }
+  return csr_graph(std::move(offsets), std::move(targets), std::move(weights));
+}
+
+/**
+ * Run Louvain local moving on one level until no move improves modularity.
+ *
+ * @param graph `const csr_graph&` symmetric weighted graph
+ * @param min_gain `double` stop a level once a full pass gains less
+ * @returns `vertex_index_vector` with the community of each vertex
+ */
+vertex_index_vector local_moving(const csr_graph& graph, double min_gain)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  double_vector degrees(n_vertices, 0);
+  double total_weight = 0;
+  for (vertex_index v = 0; v < n_vertices; v++) {
+    graph.for_each_neighbor(
+      v, [&](vertex_index, edge_index e) { degrees[v] += graph.weight(e); }
+    );
+    total_weight += degrees[v];
+  }
+  vertex_index_vector labels(n_vertices);
+  std::iota(labels.begin(), labels.end(), 0);
+  if (total_weight <= 0) {
+    return labels;
+  }
+  double_vector community_totals(degrees);
+  label_weights links(n_vertices);
+  while (true) {
+    double gain = 0;
+    for (vertex_index v = 0; v < n_vertices; v++) {
+      vertex_index old_label = labels[v];
+      links.add(old_label, 0);
+      graph.for_each_neighbor(
+        v,
+        [&](vertex_index u, edge_index e)
+        {
+          if (u != v) {
+            links.add(labels[u], graph.weight(e));
+          }
+        }
+      );
+      // modularity gain of joining community c is proportional to
+      // links(c) - totals(c) * degree(v) / total_weight
+      community_totals[old_label] -= degrees[v];
+      double scale = degrees[v] / total_weight;
+      vertex_index best_label = old_label;
+      double best_score =
+        links.weight(old_label) - community_totals[old_label] * scale;
+      double old_score = best_score;
+      for (vertex_index label : links.labels()) {
+        double score = links.weight(label) - community_totals[label] * scale;
+        if (score > best_score) {
+          best_label = label;
+          best_score = score;
+        }
+      }
+      community_totals[best_label] += degrees[v];
+      labels[v] = best_label;
+      gain += 2 * (best_score - old_score) / total_weight;
+      links.clear();
+    }
+    if (gain < min_gain) {
+      break;
+    }
+  }
+  return labels;
+}
+
+}  // namespace
+
+/**
+ * Detect communities with asynchronous parallel label propagation.
+ *
+ * Every vertex starts in its own community and repeatedly adopts the label
+ * with the largest total edge weight among its neighbors, keeping its own
+ * label on ties. Updates are written back immediately with relaxed atomics,
+ * so later vertices in the same sweep already see them, which avoids the
+ * label oscillation of synchronous updates. Each sweep visits vertices in a
+ * fresh random order split across threads.
+ *
+ * @note `graph` should be symmetric, e.g. from `csr_graph::symmetrize`.
+ *
+ * @param graph `const csr_graph&` undirected graph, optionally weighted
+ * @param max_sweeps `std::size_t` maximum number of sweeps over all vertices
+ * @param seed `std::uint64_t` random seed for the sweep orders
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+community_assignment label_propagation(
+  const csr_graph& graph,
+  std::size_t max_sweeps,
+  std::uint64_t seed,
+  std::size_t n_threads)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  std::vector<std::atomic<vertex_index>> labels(n_vertices);
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    labels[v].store(static_cast<vertex_index>(v), std::memory_order_relaxed);
+  }
+  vertex_index_vector order(n_vertices);
+  std::iota(order.begin(), order.end(), 0);
+  std::mt19937_64 rng(seed);
+  std::size_t max_threads = resolve_n_threads(n_threads);
+  std::vector<std::size_t> changes(max_threads);
+  // one table per thread for all sweeps, since clear only resets what's used
+  std::vector<label_weights> thread_counts(
+    max_threads, label_weights(n_vertices)
+  );
+  for (std::size_t sweep = 0; sweep < max_sweeps; sweep++) {
+    std::shuffle(order.begin(), order.end(), rng);
+    std::fill(changes.begin(), changes.end(), 0);
+    parallel_run(
+      max_threads,
+      [&](std::size_t thread_id)
+      {
+        // each thread takes a contiguous slice of the shuffled order
+        std::size_t begin = thread_id * n_vertices / max_threads;
+        std::size_t end = (thread_id + 1) * n_vertices / max_threads;
+        label_weights& counts = thread_counts[thread_id];
+        for (std::size_t i = begin; i < end; i++) {
+          vertex_index v = order[i];
+          vertex_index own = labels[v].load(std::memory_order_relaxed);
+          graph.for_each_neighbor(
+            v,
+            [&](vertex_index u, edge_index e)
+            {
+              if (u != v) {
+                counts.add(
+                  labels[u].load(std::memory_order_relaxed), graph.weight(e)
+                );
+              }
+            }
+          );
+          vertex_index best = own;
+          // untouched labels read as zero weight
+          double best_weight = counts.weight(own);
+          for (vertex_index label : counts.labels()) {
+            double weight = counts.weight(label);
+            if (
+              weight > best_weight ||
+              (weight == best_weight && best != own && label < best)
+            ) {
+              best = label;
+              best_weight = weight;
+            }
+          }
+          counts.clear();
+          if (best != own) {
+            labels[v].store(best, std::memory_order_relaxed);
+            changes[thread_id]++;
+          }
+        }
+      }
+    );
+    if (!std::accumulate(changes.begin(), changes.end(), std::size_t(0))) {
+      break;
+    }
+  }
+  vertex_index_vector result(n_vertices);
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    result[v] = labels[v].load(std::memory_order_relaxed);
+  }
+  return compact_labels(std::move(result));
+}
+
+/**
+ * Detect communities with the multi-level Louvain method.
+ *
+ * Each level greedily moves single vertices to the neighboring community
+ * with the best modularity gain until a full pass gains less than
+ * `min_gain`, then contracts every community into one weighted vertex and
+ * repeats on the smaller graph. Stops once a level moves nothing. Since
+ * coarse graphs shrink quickly, nearly all the time goes into the first
+ * level, which is a flat `O(E)` scan per pass.
+ *
+ * @note `graph` should be symmetric, e.g. from `csr_graph::symmetrize`.
+ *
+ * @param graph `const csr_graph&` undirected graph, optionally weighted
+ * @param min_gain `double` minimum modularity gain per pass to keep going
+ */
+community_assignment louvain(const csr_graph& graph, double min_gain)
+{
+  community_assignment result{graph.n_vertices(), vertex_index_vector()};
+  result.labels.resize(graph.n_vertices());
+  std::iota(result.labels.begin(), result.labels.end(), 0);
+  csr_graph level = graph;
+  while (true) {
+    community_assignment communities = compact_labels(
+      local_moving(level, min_gain)
+    );
+    if (communities.n_communities == level.n_vertices()) {
+      break;
+    }
+    for (vertex_index& label : result.labels) {
+      label = communities.labels[label];
+    }
+    result.n_communities = communities.n_communities;
+    level = coarsen(level, communities);
+  }
+  return result;
+}
+
+/**
+ * Compute the modularity of a community assignment.
+ *
+ * With `m` the total edge weight, this is the fraction of edge weight inside
+ * communities minus the fraction expected if edges were rewired at random
+ * keeping degrees, i.e. the sum over communities `c` of
+ * `in(c) / 2m - (tot(c) / 2m)^2`.
+ *
+ * @param graph `const csr_graph&` symmetric graph, optionally weighted
+ * @param labels `const vertex_index_vector&` community of each vertex
+ */
+double modularity(const csr_graph& graph, const vertex_index_vector& labels)
+{
+  std::size_t n_labels = 0;
+  for (vertex_index label : labels) {
+    n_labels = std::max<std::size_t>(n_labels, label + 1);
+  }
+  double_vector inside(n_labels, 0);
+  double_vector totals(n_labels, 0);
+  double total_weight = 0;
+  for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+    graph.for_each_neighbor(
+      v,
+      [&](vertex_index u, edge_index e)
+      {
+        totals[labels[v]] += graph.weight(e);
+        if (labels[u] == labels[v]) {
+          inside[labels[v]] += graph.weight(e);
+        }
+      }
+    );
+  }
+  total_weight = std::accumulate(totals.begin(), totals.end(), 0.);
+  if (total_weight <= 0) {
+    return 0;
+  }
+  double result = 0;
+  for (std::size_t c = 0; c < n_labels; c++) {
+    double fraction = totals[c] / total_weight;
+    result += inside[c] / total_weight - fraction * fraction;
+  }
+  return result;
+}
+
+}  // namespace pdcip
@@ -0,0 +1,378 @@
+/**
+ * @file compressed_graph.cc
+ * @author Derek Huang
+ * @brief C++ source for a delta and varint compressed graph representation
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/compressed_graph.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Return the number of bytes needed to encode a varint.
+ *
+ * @param value `std::uint64_t` value to encode
+ */
+inline std::size_t varint_size(std::uint64_t value)
+{
+  std::size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+/**
+ * Encode a varint, advancing `p` past it.
+ *
+ * @param p `std::uint8_t*&` write position, advanced past the varint
+ * @param value `std::uint64_t` value to encode
+ */
+inline void encode_varint(std::uint8_t*& p, std::uint64_t value)
+{
+  while (value >= 0x80) {
+    *p++ = static_cast<std::uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *p++ = static_cast<std::uint8_t>(value);
+}
+
+/**
+ * Return the zigzag encoding of the first target relative to its source.
+ *
+ * Maps small differences of either sign to small unsigned values.
+ *
+ * @param source `vertex_index` row vertex
+ * @param target `vertex_index` first target in the row
+ */
+inline std::uint64_t first_delta(vertex_index source, vertex_index target)
+{
+  std::int64_t delta = static_cast<std::int64_t>(target) - source;
+  return (static_cast<std::uint64_t>(delta) << 1) ^
+    static_cast<std::uint64_t>(delta >> 63);
+}
+
+/**
+ * Call `func(value)` for each varint encoding a row of a `csr_graph`.
+ *
+ * The first value is the out-degree, followed by the target deltas.
+ *
+ * @param graph `const csr_graph&` graph being compressed
+ * @param vert `vertex_index` row vertex
+ * @param func `F&&` callable taking each `std::uint64_t` value
+ */
+template <typename F>
+void for_each_code(const csr_graph& graph, vertex_index vert, F&& func)
+{
+  const vertex_index* first = graph.neighbors_begin(vert);
+  const vertex_index* last = graph.neighbors_end(vert);
+  func(static_cast<std::uint64_t>(last - first));
+  if (first == last) {
+    return;
+  }
+  func(first_delta(vert, *first));
+  for (const vertex_index* p = first + 1; p < last; p++) {
+    func(static_cast<std::uint64_t>(*p - *(p - 1)));
+  }
+}
+
+}  // namespace
+
+/**
+ * `compressed_graph` default constructor giving the empty graph.
+ */
+compressed_graph::compressed_graph() : byte_offsets_({0}), edge_samples_({0})
+{}
+
+/**
+ * `compressed_graph` constructor compressing a `csr_graph`.
+ *
+ * Encoded row sizes are measured in one parallel pass, prefix summed into
+ * byte offsets, and rows are then encoded in place in a second parallel
+ * pass, so no intermediate buffers are needed.
+ *
+ * @param graph `const csr_graph&` graph to compress
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+compressed_graph::compressed_graph(
+  const csr_graph& graph, std::size_t n_threads)
+  : byte_offsets_(graph.n_vertices() + 1, 0),
+    edge_samples_(graph.n_vertices() / edge_sample_interval + 1),
+    values_(graph.values(), graph.values() + graph.n_vertices())
+{
+  std::size_t n_vertices = graph.n_vertices();
+  for (std::size_t k = 0; k < edge_samples_.size(); k++) {
+    edge_samples_[k] = graph.offsets()[k * edge_sample_interval];
+  }
+  if (graph.weighted()) {
+    weights_.assign(graph.weights(), graph.weights() + graph.n_edges());
+  }
+  parallel_for(
+    n_vertices,
+    [&](std::size_t begin, std::size_t end, std::size_t)
+    {
+      for (std::size_t v = begin; v < end; v++) {
+        std::size_t size = 0;
+        for_each_code(
+          graph,
+          static_cast<vertex_index>(v),
+          [&](std::uint64_t code) { size += varint_size(code); }
+        );
+        byte_offsets_[v + 1] = size;
+      }
+    },
+    n_threads
+  );
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    byte_offsets_[v + 1] += byte_offsets_[v];
+  }
+  bytes_.resize(byte_offsets_.back());
+  parallel_for(
+    n_vertices,
+    [&](std::size_t begin, std::size_t end, std::size_t)
+    {
+      for (std::size_t v = begin; v < end; v++) {
+        std::uint8_t* p = bytes_.data() + byte_offsets_[v];
+        for_each_code(
+          graph,
+          static_cast<vertex_index>(v),
+          [&](std::uint64_t code) { encode_varint(p, code); }
+        );
+      }
+    },
+    n_threads
+  );
+}
+
+/**
+ * Return number of vertices in the `compressed_graph`.
+ */
+std::size_t compressed_graph::n_vertices() const
+{
+  return byte_offsets_.size() - 1;
+}
+
+/**
+ * Return number of directed edges in the `compressed_graph`.
+ */
+std::size_t compressed_graph::n_edges() const
+{
+  return edges_begin(static_cast<vertex_index>(n_vertices()));
+}
+
+/**
+ * Return the number of bytes used by the encoded adjacency.
+ *
+ * Counts the encoded rows, the byte offsets, and the sampled edge indices,
+ * i.e. the storage that replaces the `csr_graph` offsets and targets.
+ */
+std::size_t compressed_graph::n_bytes() const
+{
+  return bytes_.size() +
+    (byte_offsets_.size() + edge_samples_.size()) * sizeof(edge_index);
+}
+
+/**
+ * Return `true` if the `compressed_graph` stores explicit edge weights.
+ */
+bool compressed_graph::weighted() const { return !weights_.empty(); }
+
+/**
+ * Return the out-degree of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get out-degree of
+ */
+std::size_t compressed_graph::degree(vertex_index vert) const
+{
+  const std::uint8_t* p = bytes_.data() + byte_offsets_[vert];
+  return static_cast<std::size_t>(decode_varint(p));
+}
+
+/**
+ * Return index of the first out-edge of a vertex.
+ *
+ * Starts from the nearest sampled edge index at or before the vertex and
+ * adds the degrees of the rows in between.
+ *
+ * @param vert `vertex_index` vertex to get first out-edge of, or
+ *    `n_vertices()` for the number of edges
+ */
+edge_index compressed_graph::edges_begin(vertex_index vert) const
+{
+  edge_index e = edge_samples_[vert / edge_sample_interval];
+  for (vertex_index v = vert - vert % edge_sample_interval; v < vert; v++) {
+    e += degree(v);
+  }
+  return e;
+}
+
+/**
+ * Return index one past the last out-edge of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get last out-edge of
+ */
+edge_index compressed_graph::edges_end(vertex_index vert) const
+{
+  return edges_begin(vert) + degree(vert);
+}
+
+/**
+ * Return the weight of an edge, `1` if the graph is unweighted.
+ *
+ * @param e `edge_index` edge to get weight of
+ */
+double compressed_graph::weight(edge_index e) const
+{
+  return (weights_.empty()) ? 1 : weights_[e];
+}
+
+/**
+ * Return the value of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get value of
+ */
+double compressed_graph::value(vertex_index vert) const
+{
+  return values_[vert];
+}
+
+/**
+ * Return `true` if there is an edge from `start` to `end`.
+ *
+ * Decodes the row of `start` until reaching a target of at least `end`, so
+ * `O(degree(start))` in the worst case.
+ *
+ * @param start `vertex_index` starting vertex
+ * @param end `vertex_index` ending vertex
+ */
+bool compressed_graph::has_edge(vertex_index start, vertex_index end) const
+{
+  const std::uint8_t* p = bytes_.data() + byte_offsets_[start];
+  std::uint64_t n_left = decode_varint(p);
+  if (!n_left) {
+    return false;
+  }
+  std::uint64_t first = decode_varint(p);
+  auto target = static_cast<vertex_index>(
+    start + static_cast<std::int64_t>((first >> 1) ^ (~(first & 1) + 1))
+  );
+  while (target < end && --n_left) {
+    target += static_cast<vertex_index>(decode_varint(p));
+  }
+  return target == end;
+}
+
+/**
+ * Return the decoded out-neighbors of a vertex in increasing order.
+ *
+ * @param vert `vertex_index` vertex to get neighbors of
+ */
+vertex_index_vector compressed_graph::neighbors(vertex_index vert) const
+{
+  vertex_index_vector result;
+  result.reserve(degree(vert));
+  for_each_neighbor(
+    vert, [&](vertex_index target, edge_index) { result.push_back(target); }
+  );
+  return result;
+}
+
+/**
+ * Return the number of in-edges of every vertex.
+ */
+edge_index_vector compressed_graph::in_degrees() const
+{
+  edge_index_vector counts(n_vertices(), 0);
+  for (vertex_index v = 0; v < n_vertices(); v++) {
+    for_each_neighbor(v, [&](vertex_index u, edge_index) { counts[u]++; });
+  }
+  return counts;
+}
+
+/**
+ * Return the reverse of the graph as an uncompressed `csr_graph`.
+ *
+ * The rows are decoded once in order and counting sorted by target, so the
+ * original graph is never decompressed as a whole. Edges keep their weights
+ * and rows of the result come out sorted.
+ */
+csr_graph compressed_graph::transpose() const
+{
+  edge_index_vector offsets(n_vertices() + 1, 0);
+  edge_index_vector counts = in_degrees();
+  for (std::size_t v = 0; v < n_vertices(); v++) {
+    offsets[v + 1] = offsets[v] + counts[v];
+  }
+  vertex_index_vector targets(offsets.back());
+  double_vector weights(weights_.empty() ? 0 : offsets.back());
+  // counts becomes the next free slot of each reversed row
+  std::copy(offsets.begin(), offsets.end() - 1, counts.begin());
+  for (vertex_index v = 0; v < n_vertices(); v++) {
+    for_each_neighbor(
+      v,
+      [&](vertex_index u, edge_index e)
+      {
+        edge_index slot = counts[u]++;
+        targets[slot] = v;
+        if (!weights_.empty()) {
+          weights[slot] = weights_[e];
+        }
+      }
+    );
+  }
+  return csr_graph(
+    std::move(offsets),
+    std::move(targets),
+    std::move(weights),
+    double_vector(values_)
+  );
+}
+
+/**
+ * Decode the whole graph back into a `csr_graph`.
+ *
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+csr_graph compressed_graph::decompress(std::size_t n_threads) const
+{
+  edge_index_vector offsets(n_vertices() + 1, 0);
+  for (vertex_index v = 0; v < n_vertices(); v++) {
+    offsets[v + 1] = offsets[v] + degree(v);
+  }
+  vertex_index_vector targets(offsets.back());
+  parallel_for(
+    n_vertices(),
+    [&](std::size_t begin, std::size_t end, std::size_t)
+    {
+      for (std::size_t v = begin; v < end; v++) {
+        for_each_neighbor(
+          static_cast<vertex_index>(v),
+          [&](vertex_index target, edge_index e) { targets[e] = target; }
+        );
+      }
+    },
+    n_threads
+  );
+  return csr_graph(
+    std::move(offsets),
+    std::move(targets),
+    double_vector(weights_),
+    double_vector(values_)
+  );
+}
+
+}  // namespace pdcip
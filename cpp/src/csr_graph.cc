@@ -0,0 +1,558 @@
+/**
+ * @file csr_graph.cc
+ * @author Derek Huang
+ * @brief C++ source for a compressed sparse row graph representation
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/csr_graph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Stable counting sort of edge positions by a vertex key.
+ *
+ * @param n_vertices `std::size_t` number of vertices, i.e. key range
+ * @param keys `const vertex_index_vector&` key of each edge
+ * @param order `const edge_index_vector&` edge positions in current order
+ * @param offsets `edge_index_vector&` filled with `n_vertices + 1` row offsets
+ * @returns `edge_index_vector` edge positions stably sorted by key
+ */
+edge_index_vector counting_sort(
+  std::size_t n_vertices,
+  const vertex_index_vector& keys,
+  const edge_index_vector& order,
+  edge_index_vector& offsets)
+{
+  offsets.assign(n_vertices + 1, 0);
+  for (vertex_index key : keys) {
+    offsets[key + 1]++;
+  }
+  for (std::size_t i = 0; i < n_vertices; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+  edge_index_vector next(offsets.begin(), offsets.end() - 1);
+  edge_index_vector sorted(order.size());
+  for (edge_index e : order) {
+    sorted[next[keys[e]]++] = e;
+  }
+  return sorted;
+}
+
+/**
+ * Convert a coordinate edge representation into CSR arrays.
+ *
+ * Sorting by target first makes the stable sort by source leave each row
+ * ordered by target, which set intersections and `has_edge` rely on.
+ *
+ * @param n_vertices `std::size_t` number of vertices
+ * @param sources `const vertex_index_vector&` edge source vertices
+ * @param targets `const vertex_index_vector&` edge target vertices
+ * @param weights `const double_vector&` edge weights, empty if unweighted
+ * @param csr_offsets `edge_index_vector&` filled with the row offsets
+ * @param csr_targets `vertex_index_vector&` filled with the sorted targets
+ * @param csr_weights `double_vector&` filled with the sorted weights
+ */
+void coo_to_csr(
+  std::size_t n_vertices,
+  const vertex_index_vector& sources,
+  const vertex_index_vector& targets,
+  const double_vector& weights,
+  edge_index_vector& csr_offsets,
+  vertex_index_vector& csr_targets,
+  double_vector& csr_weights)
+{
+  assert(sources.size() == targets.size());
+  assert(weights.empty() || weights.size() == sources.size());
+  edge_index_vector order(sources.size());
+  for (std::size_t i = 0; i < order.size(); i++) {
+    assert(sources[i] < n_vertices && targets[i] < n_vertices);
+    order[i] = i;
+  }
+  edge_index_vector target_offsets;
+  order = counting_sort(n_vertices, targets, order, target_offsets);
+  order = counting_sort(n_vertices, sources, order, csr_offsets);
+  csr_targets.resize(order.size());
+  for (std::size_t i = 0; i < order.size(); i++) {
+    csr_targets[i] = targets[order[i]];
+  }
+  csr_weights.clear();
+  if (!weights.empty()) {
+    csr_weights.resize(order.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+      csr_weights[i] = weights[order[i]];
+    }
+  }
+}
+
+/**
+ * Owned storage backing a `csr_graph` built in memory.
+ */
+struct csr_storage {
+  edge_index_vector offsets;
+  vertex_index_vector targets;
+  double_vector weights;
+  double_vector values;
+};
+
+}  // namespace
+
+/**
+ * `csr_graph` default constructor giving the empty graph.
+ */
+csr_graph::csr_graph() : csr_graph(edge_index_vector{0}, vertex_index_vector())
+{}
+
+/**
+ * `csr_graph` constructor from `vertex` and `edge` pointers.
+ *
+ * Vertex `i` of the `csr_graph` corresponds to `vertices[i]` and takes its
+ * value. Every `edge` must connect vertices present in `vertices`.
+ *
+ * @param vertices `const vertex_ptr_vector&` with graph vertices
+ * @param edges `const edge_ptr_vector&` with graph edges
+ */
+csr_graph::csr_graph(
+  const vertex_ptr_vector& vertices, const edge_ptr_vector& edges)
+{
+  assert(vertices.size() <= std::numeric_limits<vertex_index>::max());
+  std::unordered_map<vertex_ptr, vertex_index> indices;
+  indices.reserve(vertices.size());
+  double_vector values(vertices.size());
+  for (std::size_t i = 0; i < vertices.size(); i++) {
+    assert(vertices[i] && "vertices cannot be nullptr");
+    indices.emplace(vertices[i], static_cast<vertex_index>(i));
+    values[i] = vertices[i]->value();
+  }
+  vertex_index_vector sources(edges.size());
+  vertex_index_vector targets(edges.size());
+  double_vector weights(edges.size());
+  for (std::size_t i = 0; i < edges.size(); i++) {
+    auto start = indices.find(edges[i]->start());
+    auto end = indices.find(edges[i]->end());
+    assert(start != indices.end() && end != indices.end());
+    sources[i] = start->second;
+    targets[i] = end->second;
+    weights[i] = edges[i]->weight();
+  }
+  edge_index_vector csr_offsets;
+  vertex_index_vector csr_targets;
+  double_vector csr_weights;
+  coo_to_csr(
+    vertices.size(),
+    sources,
+    targets,
+    weights,
+    csr_offsets,
+    csr_targets,
+    csr_weights
+  );
+  adopt(
+    std::move(csr_offsets),
+    std::move(csr_targets),
+    std::move(csr_weights),
+    std::move(values)
+  );
+}
+
+/**
+ * `csr_graph` constructor from a coordinate (edge array) representation.
+ *
+ * Edges are bucketed by source with a two-pass counting sort, so each row
+ * ends up sorted by target in `O(V + E)` time. Duplicate edges are kept.
+ *
+ * @param n_vertices `std::size_t` number of vertices
+ * @param sources `const vertex_index_vector&` edge source vertices
+ * @param targets `const vertex_index_vector&` edge target vertices
+ * @param weights `const double_vector&` edge weights, empty if unweighted
+ */
+csr_graph::csr_graph(
+  std::size_t n_vertices,
+  const vertex_index_vector& sources,
+  const vertex_index_vector& targets,
+  const double_vector& weights)
+{
+  edge_index_vector csr_offsets;
+  vertex_index_vector csr_targets;
+  double_vector csr_weights;
+  coo_to_csr(
+    n_vertices,
+    sources,
+    targets,
+    weights,
+    csr_offsets,
+    csr_targets,
+    csr_weights
+  );
+  adopt(
+    std::move(csr_offsets),
+    std::move(csr_targets),
+    std::move(csr_weights),
+    double_vector()
+  );
+}
+
+/**
+ * `csr_graph` constructor that moves from prebuilt CSR arrays.
+ *
+ * @note Rows are expected to already be sorted by target.
+ *
+ * @param offsets `edge_index_vector&&` with `n_vertices + 1` row offsets
+ * @param targets `vertex_index_vector&&` with edge targets
+ * @param weights `double_vector&&` with edge weights, empty if unweighted
+ * @param values `double_vector&&` with vertex values, empty for `NAN` values
+ */
+csr_graph::csr_graph(
+  edge_index_vector&& offsets,
+  vertex_index_vector&& targets,
+  double_vector&& weights,
+  double_vector&& values)
+{
+  adopt(
+    std::move(offsets),
+    std::move(targets),
+    std::move(weights),
+    std::move(values)
+  );
+}
+
+/**
+ * `csr_graph` constructor viewing CSR arrays owned by someone else.
+ *
+ * No data is copied. `storage` is held for the lifetime of the graph and all
+ * of its copies, so it should own whatever memory the arrays point into,
+ * e.g. a memory-mapped file.
+ *
+ * @note Rows are expected to already be sorted by target.
+ *
+ * @param n_vertices `std::size_t` number of vertices
+ * @param n_edges `std::size_t` number of edges
+ * @param offsets `const edge_index*` with `n_vertices + 1` row offsets
+ * @param targets `const vertex_index*` with `n_edges` edge targets
+ * @param weights `const double*` with `n_edges` weights, `nullptr` if
+ *    unweighted
+ * @param values `const double*` with `n_vertices` vertex values
+ * @param storage `std::shared_ptr<const void>` owner of the arrays
+ */
+csr_graph::csr_graph(
+  std::size_t n_vertices,
+  std::size_t n_edges,
+  const edge_index* offsets,
+  const vertex_index* targets,
+  const double* weights,
+  const double* values,
+  std::shared_ptr<const void> storage)
+  : n_vertices_(n_vertices),
+    n_edges_(n_edges),
+    offsets_(offsets),
+    targets_(targets),
+    weights_(weights),
+    values_(values),
+    storage_(std::move(storage))
+{
+  assert(offsets_ && offsets_[n_vertices_] == n_edges_);
+  assert((targets_ || !n_edges_) && (values_ || !n_vertices_));
+}
+
+/**
+ * Take ownership of CSR arrays and point the graph at them.
+ *
+ * @param offsets `edge_index_vector&&` with `n_vertices + 1` row offsets
+ * @param targets `vertex_index_vector&&` with edge targets
+ * @param weights `double_vector&&` with edge weights, empty if unweighted
+ * @param values `double_vector&&` with vertex values, empty for `NAN` values
+ */
+void csr_graph::adopt(
+  edge_index_vector&& offsets,
+  vertex_index_vector&& targets,
+  double_vector&& weights,
+  double_vector&& values)
+{
+  assert(!offsets.empty() && offsets.back() == targets.size());
+  assert(weights.empty() || weights.size() == targets.size());
+  if (values.empty()) {
+    values.assign(offsets.size() - 1, NAN);
+  }
+  assert(values.size() == offsets.size() - 1);
+  auto storage = std::make_shared<csr_storage>();
+  storage->offsets = std::move(offsets);
+  storage->targets = std::move(targets);
+  storage->weights = std::move(weights);
+  storage->values = std::move(values);
+  n_vertices_ = storage->values.size();
+  n_edges_ = storage->targets.size();
+  offsets_ = storage->offsets.data();
+  targets_ = storage->targets.data();
+  weights_ = (storage->weights.empty()) ? nullptr : storage->weights.data();
+  values_ = storage->values.data();
+  storage_ = std::move(storage);
+}
+
+/**
+ * Return number of vertices in the `csr_graph`.
+ */
+std::size_t csr_graph::n_vertices() const { return n_vertices_; }
+
+/**
+ * Return number of directed edges in the `csr_graph`.
+ */
+std::size_t csr_graph::n_edges() const { return n_edges_; }
+
+/**
+ * Return `true` if the `csr_graph` stores explicit edge weights.
+ */
+bool csr_graph::weighted() const { return weights_ != nullptr; }
+
+/**
+ * Return the out-degree of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get out-degree of
+ */
+std::size_t csr_graph::degree(vertex_index vert) const
+{
+  return offsets_[vert + 1] - offsets_[vert];
+}
+
+/**
+ * Return pointer to the `n_vertices() + 1` row offsets.
+ */
+const edge_index* csr_graph::offsets() const { return offsets_; }
+
+/**
+ * Return pointer to the `n_edges()` edge targets.
+ */
+const vertex_index* csr_graph::targets() const { return targets_; }
+
+/**
+ * Return pointer to the `n_edges()` edge weights, `nullptr` if unweighted.
+ */
+const double* csr_graph::weights() const { return weights_; }
+
+/**
+ * Return pointer to the `n_vertices()` vertex values.
+ */
+const double* csr_graph::values() const { return values_; }
+
+/**
+ * Return index of the first out-edge of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get first out-edge of
+ */
+edge_index csr_graph::edges_begin(vertex_index vert) const
+{
+  return offsets_[vert];
+}
+
+/**
+ * Return index one past the last out-edge of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get last out-edge of
+ */
+edge_index csr_graph::edges_end(vertex_index vert) const
+{
+  return offsets_[vert + 1];
+}
+
+/**
+ * Return pointer to the first out-neighbor of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get neighbors of
+ */
+const vertex_index* csr_graph::neighbors_begin(vertex_index vert) const
+{
+  return targets_ + offsets_[vert];
+}
+
+/**
+ * Return pointer one past the last out-neighbor of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get neighbors of
+ */
+const vertex_index* csr_graph::neighbors_end(vertex_index vert) const
+{
+  return targets_ + offsets_[vert + 1];
+}
+
+/**
+ * Return the target vertex of an edge.
+ *
+ * @param e `edge_index` edge to get target of
+ */
+vertex_index csr_graph::target(edge_index e) const { return targets_[e]; }
+
+/**
+ * Return the weight of an edge, `1` if the graph is unweighted.
+ *
+ * @param e `edge_index` edge to get weight of
+ */
+double csr_graph::weight(edge_index e) const
+{
+  return (weights_) ? weights_[e] : 1;
+}
+
+/**
+ * Return the value of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get value of
+ */
+double csr_graph::value(vertex_index vert) const { return values_[vert]; }
+
+/**
+ * Return `true` if there is an edge from `start` to `end`.
+ *
+ * Binary search on the sorted row, so `O(log(degree(start)))`.
+ *
+ * @param start `vertex_index` starting vertex
+ * @param end `vertex_index` ending vertex
+ */
+bool csr_graph::has_edge(vertex_index start, vertex_index end) const
+{
+  return std::binary_search(neighbors_begin(start), neighbors_end(start), end);
+}
+
+/**
+ * Return the transpose of the `csr_graph`, i.e. with all edges reversed.
+ *
+ * Row `v` of the transpose lists the in-neighbors of `v`, which is what
+ * pull-based algorithms iterate over.
+ */
+csr_graph csr_graph::transpose() const
+{
+  edge_index_vector offsets;
+  vertex_index_vector targets;
+  double_vector weights;
+  coo_to_csr(
+    n_vertices_,
+    vertex_index_vector(targets_, targets_ + n_edges_),
+    edge_sources(),
+    (weights_) ? double_vector(weights_, weights_ + n_edges_) : double_vector(),
+    offsets,
+    targets,
+    weights
+  );
+  return csr_graph(
+    std::move(offsets),
+    std::move(targets),
+    std::move(weights),
+    double_vector(values_, values_ + n_vertices_)
+  );
+}
+
+/**
+ * Return the undirected closure of the `csr_graph`.
+ *
+ * Every edge `(u, v)` appears as both `(u, v)` and `(v, u)`. Parallel edges
+ * between the same pair of vertices are merged into one edge carrying the
+ * smallest of their weights, so rows of the result have unique targets.
+ */
+csr_graph csr_graph::symmetrize() const
+{
+  vertex_index_vector sources;
+  vertex_index_vector targets;
+  double_vector weights;
+  sources.reserve(2 * n_edges());
+  targets.reserve(2 * n_edges());
+  weights.reserve(2 * n_edges());
+  for (std::size_t v = 0; v < n_vertices(); v++) {
+    for (edge_index e = offsets_[v]; e < offsets_[v + 1]; e++) {
+      auto u = static_cast<vertex_index>(v);
+      sources.push_back(u);
+      targets.push_back(targets_[e]);
+      weights.push_back(weight(e));
+      if (targets_[e] != u) {
+        sources.push_back(targets_[e]);
+        targets.push_back(u);
+        weights.push_back(weight(e));
+      }
+    }
+  }
+  edge_index_vector offsets;
+  vertex_index_vector merged_targets;
+  double_vector merged_weights;
+  coo_to_csr(
+    n_vertices(),
+    sources,
+    targets,
+    weights,
+    offsets,
+    merged_targets,
+    merged_weights
+  );
+  // rows are sorted by target, so duplicates are adjacent
+  std::size_t n_kept = 0;
+  edge_index row_begin = 0;
+  for (std::size_t v = 0; v < n_vertices(); v++) {
+    edge_index row_end = offsets[v + 1];
+    offsets[v] = n_kept;
+    for (edge_index e = row_begin; e < row_end; e++) {
+      if (
+        n_kept > offsets[v] && merged_targets[n_kept - 1] == merged_targets[e]
+      ) {
+        merged_weights[n_kept - 1] =
+          std::min(merged_weights[n_kept - 1], merged_weights[e]);
+        continue;
+      }
+      merged_targets[n_kept] = merged_targets[e];
+      merged_weights[n_kept] = merged_weights[e];
+      n_kept++;
+    }
+    row_begin = row_end;
+  }
+  offsets[n_vertices()] = n_kept;
+  merged_targets.resize(n_kept);
+  merged_weights.resize(n_kept);
+  if (!weighted()) {
+    merged_weights.clear();
+  }
+  return csr_graph(
+    std::move(offsets),
+    std::move(merged_targets),
+    std::move(merged_weights),
+    double_vector(values_, values_ + n_vertices_)
+  );
+}
+
+/**
+ * Return the in-degree of every vertex.
+ */
+edge_index_vector csr_graph::in_degrees() const
+{
+  edge_index_vector counts(n_vertices(), 0);
+  for (edge_index e = 0; e < n_edges_; e++) {
+    counts[targets_[e]]++;
+  }
+  return counts;
+}
+
+/**
+ * Return the source vertex of every edge, i.e. the row each edge lies in.
+ */
+vertex_index_vector csr_graph::edge_sources() const
+{
+  vertex_index_vector sources(n_edges());
+  for (std::size_t v = 0; v < n_vertices(); v++) {
+    std::fill(
+      sources.begin() + offsets_[v],
+      sources.begin() + offsets_[v + 1],
+      static_cast<vertex_index>(v)
+    );
+  }
+  return sources;
+}
+
+}  // namespace pdcip
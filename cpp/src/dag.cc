@@ -0,0 +1,237 @@
+/**
+ * @file dag.cc
+ * @author Derek Huang
+ * @brief C++ source for topological sorting and DAG task scheduling
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/dag.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/compressed_graph.h"
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Run tasks level by level, with a barrier between consecutive levels.
+ *
+ * @param levels `const topological_levels&` precomputed levels
+ * @param func `const std::function<void(vertex_index)>&` task callback
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+void schedule_levels(
+  const topological_levels& levels,
+  const std::function<void(vertex_index)>& func,
+  std::size_t n_threads)
+{
+  for (std::size_t i = 0; i < levels.n_levels(); i++) {
+    const vertex_index* level = levels.order.data() + levels.level_offsets[i];
+    parallel_for(
+      levels.level_offsets[i + 1] - levels.level_offsets[i],
+      [&](std::size_t begin, std::size_t end, std::size_t)
+      {
+        for (std::size_t j = begin; j < end; j++) {
+          func(level[j]);
+        }
+      },
+      n_threads,
+      1
+    );
+  }
+}
+
+/**
+ * Run tasks as soon as all of their dependencies have finished.
+ *
+ * Each vertex holds an atomic count of unfinished dependencies. The worker
+ * that finishes the last dependency of a vertex pushes it onto a shared ready
+ * stack, so no level barriers are needed and long tasks do not hold back
+ * unrelated ones.
+ *
+ * @param graph `const csr_graph&` dependency graph
+ * @param func `const std::function<void(vertex_index)>&` task callback
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::size_t` number of tasks run
+ */
+std::size_t schedule_dependencies(
+  const csr_graph& graph,
+  const std::function<void(vertex_index)>& func,
+  std::size_t n_threads)
+{
+  edge_index_vector in_degrees = graph.in_degrees();
+  std::vector<std::atomic<std::size_t>> remaining(graph.n_vertices());
+  vertex_index_vector ready;
+  for (std::size_t v = 0; v < graph.n_vertices(); v++) {
+    remaining[v].store(in_degrees[v], std::memory_order_relaxed);
+    if (!in_degrees[v]) {
+      ready.push_back(static_cast<vertex_index>(v));
+    }
+  }
+  if (ready.empty()) {
+    return 0;
+  }
+  std::mutex ready_mutex;
+  std::condition_variable ready_cond;
+  // tasks that are either queued or running. reaching zero means done
+  std::size_t pending = ready.size();
+  std::atomic<std::size_t> n_run(0);
+  parallel_run(
+    n_threads,
+    [&](std::size_t)
+    {
+      vertex_index_vector newly_ready;
+      while (true) {
+        vertex_index vert;
+        {
+          std::unique_lock<std::mutex> lock(ready_mutex);
+          ready_cond.wait(lock, [&] { return !ready.empty() || !pending; });
+          if (ready.empty()) {
+            return;
+          }
+          vert = ready.back();
+          ready.pop_back();
+        }
+        func(vert);
+        n_run.fetch_add(1, std::memory_order_relaxed);
+        newly_ready.clear();
+        graph.for_each_neighbor(
+          vert,
+          [&](vertex_index next, edge_index)
+          {
+            if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+              newly_ready.push_back(next);
+            }
+          }
+        );
+        std::lock_guard<std::mutex> lock(ready_mutex);
+        ready.insert(ready.end(), newly_ready.begin(), newly_ready.end());
+        pending += newly_ready.size();
+        pending--;
+        if (!pending || newly_ready.size() > 1) {
+          ready_cond.notify_all();
+        }
+        else if (newly_ready.size()) {
+          ready_cond.notify_one();
+        }
+      }
+    }
+  );
+  return n_run.load();
+}
+
+/**
+ * Topologically sort a directed graph of any representation.
+ *
+ * @tparam graph_t `csr_graph` or `compressed_graph`
+ * @param graph `const graph_t&` graph where edge `(u, v)` means that `u`
+ *    must come before `v`
+ */
+template <typename graph_t>
+topological_levels kahn_levels(const graph_t& graph)
+{
+  topological_levels levels;
+  levels.n_vertices = graph.n_vertices();
+  levels.order.reserve(graph.n_vertices());
+  levels.level_offsets.push_back(0);
+  edge_index_vector remaining = graph.in_degrees();
+  for (std::size_t v = 0; v < graph.n_vertices(); v++) {
+    if (!remaining[v]) {
+      levels.order.push_back(static_cast<vertex_index>(v));
+    }
+  }
+  // the order doubles as the queue; [level_begin, level_end) is the frontier
+  std::size_t level_begin = 0;
+  while (level_begin < levels.order.size()) {
+    std::size_t level_end = levels.order.size();
+    levels.level_offsets.push_back(level_end);
+    for (std::size_t i = level_begin; i < level_end; i++) {
+      graph.for_each_neighbor(
+        levels.order[i],
+        [&](vertex_index next, edge_index)
+        {
+          if (!--remaining[next]) {
+            levels.order.push_back(next);
+          }
+        }
+      );
+    }
+    level_begin = level_end;
+  }
+  return levels;
+}
+
+}  // namespace
+
+/**
+ * Topologically sort a directed graph using Kahn's algorithm.
+ *
+ * Vertices are peeled off in rounds: each round takes every vertex whose
+ * remaining in-degree is zero, which yields the dependency levels for free.
+ * Runs in `O(V + E)` time.
+ *
+ * @param graph `const csr_graph&` graph where edge `(u, v)` means that `u`
+ *    must come before `v`
+ * @returns `topological_levels` with the order and its level boundaries
+ */
+topological_levels topological_sort(const csr_graph& graph)
+{
+  return kahn_levels(graph);
+}
+
+/**
+ * Topologically sort a compressed directed graph using Kahn's algorithm.
+ *
+ * Rows are decoded as they are visited, so the graph is never decompressed.
+ *
+ * @param graph `const compressed_graph&` graph where edge `(u, v)` means that
+ *    `u` must come before `v`
+ * @returns `topological_levels` with the order and its level boundaries
+ */
+topological_levels topological_sort(const compressed_graph& graph)
+{
+  return kahn_levels(graph);
+}
+
+/**
+ * Run a task per vertex of a DAG on multiple threads, respecting dependencies.
+ *
+ * A task for vertex `v` only starts after the tasks of all vertices with an
+ * edge into `v` have finished. If the graph has a cycle, the tasks on or
+ * downstream of the cycle are never run, which can be detected by comparing
+ * the return value against `graph.n_vertices()`.
+ *
+ * @param graph `const csr_graph&` dependency graph
+ * @param func `const std::function<void(vertex_index)>&` task callback, which
+ *    must be safe to call concurrently for different vertices
+ * @param schedule `dag_schedule_type` scheduling strategy
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::size_t` number of tasks run
+ */
+std::size_t dag_schedule(
+  const csr_graph& graph,
+  const std::function<void(vertex_index)>& func,
+  dag_schedule_type schedule,
+  std::size_t n_threads)
+{
+  if (schedule == dag_schedule_type::level_sync) {
+    topological_levels levels = topological_sort(graph);
+    schedule_levels(levels, func, n_threads);
+    return levels.order.size();
+  }
+  return schedule_dependencies(graph, func, n_threads);
+}
+
+}  // namespace pdcip
@@ -0,0 +1,435 @@
+/**
+ * @file dynamic_graph.cc
+ * @author Derek Huang
+ * @brief C++ source for a mutable graph with batched edge updates
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/dynamic_graph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Return the start of every run of equal sources in a sorted batch.
+ *
+ * @param sources `const vertex_index_vector&` edge sources of the batch
+ * @param order `const edge_index_vector&` batch positions sorted by source
+ * @returns `edge_index_vector` of run starts followed by `order.size()`
+ */
+edge_index_vector source_runs(
+  const vertex_index_vector& sources, const edge_index_vector& order)
+{
+  edge_index_vector runs;
+  for (std::size_t i = 0; i < order.size(); i++) {
+    if (!i || sources[order[i]] != sources[order[i - 1]]) {
+      runs.push_back(i);
+    }
+  }
+  runs.push_back(order.size());
+  return runs;
+}
+
+}  // namespace
+
+/**
+ * `dynamic_graph` constructor for a graph without edges.
+ *
+ * @param n_vertices `std::size_t` initial number of vertices
+ * @param weighted `bool` `true` to store edge weights
+ */
+dynamic_graph::dynamic_graph(std::size_t n_vertices, bool weighted)
+  : rows_(n_vertices),
+    values_(n_vertices, NAN),
+    n_edges_(0),
+    weighted_(weighted)
+{}
+
+/**
+ * `dynamic_graph` constructor copying a `csr_graph`.
+ *
+ * Duplicate edges of `graph` are kept as given, so `graph` should have
+ * unique targets per row, e.g. from `csr_graph::symmetrize`.
+ *
+ * @param graph `const csr_graph&` graph to copy
+ */
+dynamic_graph::dynamic_graph(const csr_graph& graph)
+  : rows_(graph.n_vertices()),
+    values_(graph.values(), graph.values() + graph.n_vertices()),
+    n_edges_(graph.n_edges()),
+    weighted_(graph.weighted())
+{
+  for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+    rows_[v].targets.assign(graph.neighbors_begin(v), graph.neighbors_end(v));
+    if (weighted_) {
+      rows_[v].weights.assign(
+        graph.weights() + graph.edges_begin(v),
+        graph.weights() + graph.edges_end(v)
+      );
+    }
+  }
+}
+
+/**
+ * Return number of vertices in the `dynamic_graph`.
+ */
+std::size_t dynamic_graph::n_vertices() const { return rows_.size(); }
+
+/**
+ * Return number of directed edges in the `dynamic_graph`.
+ */
+std::size_t dynamic_graph::n_edges() const { return n_edges_; }
+
+/**
+ * Return `true` if the `dynamic_graph` stores edge weights.
+ */
+bool dynamic_graph::weighted() const { return weighted_; }
+
+/**
+ * Return the out-degree of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get out-degree of
+ */
+std::size_t dynamic_graph::degree(vertex_index vert) const
+{
+  return rows_[vert].targets.size();
+}
+
+/**
+ * Return `true` if there is an edge from `start` to `end`.
+ *
+ * @param start `vertex_index` starting vertex
+ * @param end `vertex_index` ending vertex
+ */
+bool dynamic_graph::has_edge(vertex_index start, vertex_index end) const
+{
+  const vertex_index_vector& targets = rows_[start].targets;
+  return std::binary_search(targets.begin(), targets.end(), end);
+}
+
+/**
+ * Return the weight of the edge from `start` to `end`.
+ *
+ * @param start `vertex_index` starting vertex
+ * @param end `vertex_index` ending vertex
+ * @returns `double` edge weight, `1` if the graph is unweighted, and `NAN`
+ *    if there is no such edge
+ */
+double dynamic_graph::weight(vertex_index start, vertex_index end) const
+{
+  const row& adjacent = rows_[start];
+  auto it = std::lower_bound(
+    adjacent.targets.begin(), adjacent.targets.end(), end
+  );
+  if (it == adjacent.targets.end() || *it != end) {
+    return NAN;
+  }
+  return (weighted_) ? adjacent.weights[it - adjacent.targets.begin()] : 1;
+}
+
+/**
+ * Return the value of a vertex.
+ *
+ * @param vert `vertex_index` vertex to get value of
+ */
+double dynamic_graph::value(vertex_index vert) const { return values_[vert]; }
+
+/**
+ * Set the value of a vertex.
+ *
+ * @param vert `vertex_index` vertex to set value of
+ * @param value `double` new value
+ */
+void dynamic_graph::set_value(vertex_index vert, double value)
+{
+  values_[vert] = value;
+}
+
+/**
+ * Append isolated vertices with `NAN` values.
+ *
+ * @param count `std::size_t` number of vertices to add
+ */
+void dynamic_graph::add_vertices(std::size_t count)
+{
+  assert(
+    rows_.size() + count <= std::numeric_limits<vertex_index>::max() &&
+    "too many vertices"
+  );
+  rows_.resize(rows_.size() + count);
+  values_.resize(rows_.size(), NAN);
+}
+
+/**
+ * Return batch positions sorted by source, then target, then position.
+ *
+ * Sorting by position last makes the final entry of a run of duplicate
+ * edges the one that was given last.
+ *
+ * @param sources `const vertex_index_vector&` edge sources of the batch
+ * @param targets `const vertex_index_vector&` edge targets of the batch
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+edge_index_vector dynamic_graph::sort_batch(
+  const vertex_index_vector& sources,
+  const vertex_index_vector& targets,
+  std::size_t n_threads) const
+{
+  assert(sources.size() == targets.size());
+  edge_index_vector order(sources.size());
+  std::iota(order.begin(), order.end(), 0);
+  parallel_sort(
+    order.begin(),
+    order.end(),
+    [&](edge_index a, edge_index b)
+    {
+      if (sources[a] != sources[b]) {
+        return sources[a] < sources[b];
+      }
+      if (targets[a] != targets[b]) {
+        return targets[a] < targets[b];
+      }
+      return a < b;
+    },
+    n_threads
+  );
+  return order;
+}
+
+/**
+ * Insert a batch of edges in parallel.
+ *
+ * The batch is sorted by source and target, then every row touched by the
+ * batch is merged with its sorted slice on one thread, appending directly
+ * when the slice lies past the end of the row. Inserting an existing edge
+ * overwrites its weight, and within the batch the last duplicate wins.
+ * Vertices are added as needed to fit the largest index in the batch.
+ *
+ * @param sources `const vertex_index_vector&` edge sources
+ * @param targets `const vertex_index_vector&` edge targets
+ * @param weights `const double_vector&` edge weights, empty for weight `1`,
+ *    ignored if the graph is unweighted
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::size_t` number of edges that were not already present
+ */
+std::size_t dynamic_graph::insert_edges(
+  const vertex_index_vector& sources,
+  const vertex_index_vector& targets,
+  const double_vector& weights,
+  std::size_t n_threads)
+{
+  assert(weights.empty() || weights.size() == sources.size());
+  std::size_t max_vertex = 0;
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    max_vertex = std::max<std::size_t>(
+      max_vertex, std::max(sources[i], targets[i]) + std::size_t(1)
+    );
+  }
+  if (max_vertex > n_vertices()) {
+    add_vertices(max_vertex - n_vertices());
+  }
+  edge_index_vector order = sort_batch(sources, targets, n_threads);
+  edge_index_vector runs = source_runs(sources, order);
+  auto batch_weight = [&](std::size_t i)
+  {
+    return (weights.empty()) ? 1. : weights[order[i]];
+  };
+  std::size_t max_threads = resolve_n_threads(n_threads);
+  std::vector<row> buffers(max_threads);
+  std::vector<std::size_t> n_added(max_threads, 0);
+  parallel_for(
+    runs.size() - 1,
+    [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+    {
+      row& merged = buffers[thread_id];
+      for (std::size_t run = begin; run < end; run++) {
+        row& adjacent = rows_[sources[order[runs[run]]]];
+        std::size_t i = 0;
+        std::size_t j = runs[run];
+        std::size_t j_end = runs[run + 1];
+        bool append = adjacent.targets.empty() ||
+          adjacent.targets.back() < targets[order[j]];
+        if (!append) {
+          merged.targets.clear();
+          merged.weights.clear();
+        }
+        row& out = (append) ? adjacent : merged;
+        std::size_t n_old = adjacent.targets.size();
+        while (j < j_end) {
+          vertex_index target = targets[order[j]];
+          // skip to the last duplicate of this target in the batch
+          while (j + 1 < j_end && targets[order[j + 1]] == target) {
+            j++;
+          }
+          if (!append) {
+            for (; i < n_old && adjacent.targets[i] < target; i++) {
+              out.targets.push_back(adjacent.targets[i]);
+              if (weighted_) {
+                out.weights.push_back(adjacent.weights[i]);
+              }
+            }
+          }
+          if (!append && i < n_old && adjacent.targets[i] == target) {
+            i++;
+          }
+          else {
+            n_added[thread_id]++;
+          }
+          out.targets.push_back(target);
+          if (weighted_) {
+            out.weights.push_back(batch_weight(j));
+          }
+          j++;
+        }
+        if (!append) {
+          out.targets.insert(
+            out.targets.end(),
+            adjacent.targets.begin() + static_cast<std::ptrdiff_t>(i),
+            adjacent.targets.end()
+          );
+          if (weighted_) {
+            out.weights.insert(
+              out.weights.end(),
+              adjacent.weights.begin() + static_cast<std::ptrdiff_t>(i),
+              adjacent.weights.end()
+            );
+          }
+          std::swap(adjacent, merged);
+        }
+      }
+    },
+    n_threads,
+    16
+  );
+  std::size_t total = std::accumulate(
+    n_added.begin(), n_added.end(), std::size_t(0)
+  );
+  n_edges_ += total;
+  return total;
+}
+
+/**
+ * Remove a batch of edges in parallel.
+ *
+ * The batch is sorted like in `insert_edges` and every touched row is
+ * filtered in place on one thread. Edges that are not present are ignored.
+ *
+ * @param sources `const vertex_index_vector&` edge sources
+ * @param targets `const vertex_index_vector&` edge targets
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::size_t` number of edges removed
+ */
+std::size_t dynamic_graph::remove_edges(
+  const vertex_index_vector& sources,
+  const vertex_index_vector& targets,
+  std::size_t n_threads)
+{
+  edge_index_vector order = sort_batch(sources, targets, n_threads);
+  edge_index_vector runs = source_runs(sources, order);
+  std::vector<std::size_t> n_removed(resolve_n_threads(n_threads), 0);
+  parallel_for(
+    runs.size() - 1,
+    [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+    {
+      for (std::size_t run = begin; run < end; run++) {
+        vertex_index source = sources[order[runs[run]]];
+        if (source >= rows_.size()) {
+          continue;
+        }
+        row& adjacent = rows_[source];
+        std::size_t j = runs[run];
+        std::size_t j_end = runs[run + 1];
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < adjacent.targets.size(); i++) {
+          vertex_index target = adjacent.targets[i];
+          while (j < j_end && targets[order[j]] < target) {
+            j++;
+          }
+          if (j < j_end && targets[order[j]] == target) {
+            n_removed[thread_id]++;
+            continue;
+          }
+          adjacent.targets[kept] = target;
+          if (weighted_) {
+            adjacent.weights[kept] = adjacent.weights[i];
+          }
+          kept++;
+        }
+        adjacent.targets.resize(kept);
+        if (weighted_) {
+          adjacent.weights.resize(kept);
+        }
+      }
+    },
+    n_threads,
+    16
+  );
+  std::size_t total = std::accumulate(
+    n_removed.begin(), n_removed.end(), std::size_t(0)
+  );
+  n_edges_ -= total;
+  return total;
+}
+
+/**
+ * Compact the graph into a `csr_graph`.
+ *
+ * Row offsets are a prefix sum over the degrees and rows are then copied in
+ * parallel. Since rows are already sorted, no sorting is needed.
+ *
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+csr_graph dynamic_graph::to_csr(std::size_t n_threads) const
+{
+  edge_index_vector offsets(rows_.size() + 1, 0);
+  for (std::size_t v = 0; v < rows_.size(); v++) {
+    offsets[v + 1] = offsets[v] + rows_[v].targets.size();
+  }
+  vertex_index_vector targets(n_edges_);
+  double_vector weights((weighted_) ? n_edges_ : 0);
+  parallel_for(
+    rows_.size(),
+    [&](std::size_t begin, std::size_t end, std::size_t)
+    {
+      for (std::size_t v = begin; v < end; v++) {
+        const row& adjacent = rows_[v];
+        auto out = static_cast<std::ptrdiff_t>(offsets[v]);
+        std::copy(
+          adjacent.targets.begin(),
+          adjacent.targets.end(),
+          targets.begin() + out
+        );
+        if (weighted_) {
+          std::copy(
+            adjacent.weights.begin(),
+            adjacent.weights.end(),
+            weights.begin() + out
+          );
+        }
+      }
+    },
+    n_threads
+  );
+  return csr_graph(
+    std::move(offsets),
+    std::move(targets),
+    std::move(weights),
+    double_vector(values_)
+  );
+}
+
+}  // namespace pdcip
@@ -0,0 +1,116 @@
+/**
+ * @file fenwick_tree.cc
+ * @author Derek Huang
+ * @brief C++ source for a Fenwick (binary indexed) tree
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/fenwick_tree.h"
+
+#include <cassert>
+#include <cstddef>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * `fenwick_tree` constructor.
+ *
+ * Builds in `O(n)` by adding each slot's sum into the next slot covering it.
+ *
+ * @param values `const double_vector&` initial values
+ */
+fenwick_tree::fenwick_tree(const double_vector& values)
+  : sums_(values.size() + 1, 0)
+{
+  for (std::size_t i = 1; i < sums_.size(); i++) {
+    sums_[i] += values[i - 1];
+    std::size_t parent = i + (i & (~i + 1));
+    if (parent < sums_.size()) {
+      sums_[parent] += sums_[i];
+    }
+  }
+}
+
+/**
+ * Return number of values.
+ */
+std::size_t fenwick_tree::size() const { return sums_.size() - 1; }
+
+/**
+ * Add to the value at a position.
+ *
+ * @param pos `std::size_t` position
+ * @param delta `double` amount to add
+ */
+void fenwick_tree::add(std::size_t pos, double delta)
+{
+  assert(pos < size());
+  for (std::size_t i = pos + 1; i < sums_.size(); i += i & (~i + 1)) {
+    sums_[i] += delta;
+  }
+}
+
+/**
+ * Set the value at a position.
+ *
+ * @param pos `std::size_t` position
+ * @param value `double` new value
+ */
+void fenwick_tree::set(std::size_t pos, double value)
+{
+  add(pos, value - this->value(pos));
+}
+
+/**
+ * Return the sum of the values before a position.
+ *
+ * @param end `std::size_t` one past the last position summed
+ */
+double fenwick_tree::prefix_sum(std::size_t end) const
+{
+  assert(end <= size());
+  double result = 0;
+  for (std::size_t i = end; i; i &= i - 1) {
+    result += sums_[i];
+  }
+  return result;
+}
+
+/**
+ * Return the sum of values in `[begin, end)`.
+ *
+ * Only the slots where the two prefix walks differ are visited, so short
+ * ranges cost less than two full prefix sums.
+ *
+ * @param begin `std::size_t` first position
+ * @param end `std::size_t` one past the last position
+ */
+double fenwick_tree::sum(std::size_t begin, std::size_t end) const
+{
+  assert(begin <= end && end <= size());
+  double result = 0;
+  // clearing the lowest set bit steps to a smaller prefix, so stepping the
+  // larger position makes both meet where the prefix sums agree
+  while (begin != end) {
+    if (end > begin) {
+      result += sums_[end];
+      end &= end - 1;
+    }
+    else {
+      result -= sums_[begin];
+      begin &= begin - 1;
+    }
+  }
+  return result;
+}
+
+/**
+ * Return the value at a position.
+ *
+ * @param pos `std::size_t` position
+ */
+double fenwick_tree::value(std::size_t pos) const { return sum(pos, pos + 1); }
+
+}  // namespace pdcip
@@ -9,8 +9,14 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <utility>
 
+#include "pdcip/cpp/bloom_filter.h"
+#include "pdcip/cpp/flat_hash_map.h"
 #include "pdcip/cpp/types.h"
 
 namespace pdcip {
@@ -176,17 +182,435 @@ bool operator!=(const edge& first, const edge& second)
   return !(first == second);
 }
 
+/**
+ * `edge_weights` constructor giving an empty set of weights.
+ */
+edge_weights::edge_weights() : size_(0), inline_{} {}
+
+/**
+ * Return number of distinct weights.
+ */
+std::size_t edge_weights::size() const { return size_; }
+
+/**
+ * Return the weight at a position, in order of insertion.
+ *
+ * @param i `std::size_t` position less than `size()`
+ */
+double edge_weights::operator[](std::size_t i) const
+{
+  assert(i < size_);
+  return (i < n_inline) ? inline_[i] : overflow_[i - n_inline];
+}
+
+/**
+ * Return `true` if a weight is present.
+ *
+ * @param weight `double` weight to look for
+ */
+bool edge_weights::contains(double weight) const
+{
+  for (std::size_t i = 0; i < size_; i++) {
+    if ((*this)[i] == weight) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Add a weight if not already present.
+ *
+ * @param weight `double` weight to add
+ * @returns `true` if the weight was added
+ */
+bool edge_weights::insert(double weight)
+{
+  if (contains(weight)) {
+    return false;
+  }
+  if (size_ < n_inline) {
+    inline_[size_] = weight;
+  }
+  else {
+    overflow_.push_back(weight);
+  }
+  size_++;
+  return true;
+}
+
+/**
+ * `graph` default constructor giving an empty graph.
+ */
+graph::graph() {}
+
 /**
  * `graph` copy from object constructor.
  *
  * @param vertices `const vertex_ptr_vector&` with graph vertices
- * @param edges `const edge_ptr_vector&` with edge vertices
+ * @param edges `const edge_ptr_vector&` with graph edges
  */
-/*
 graph::graph(const vertex_ptr_vector& vertices, const edge_ptr_vector& edges)
 {
+  add_vertices(vertices);
+  add_edges(edges);
+}
+
+/**
+ * `graph` copy from pointer constructor.
+ *
+ * @param vertices `const vertex_ptr_vector_ptr&` with graph vertices
+ * @param edges `const edge_ptr_vector_ptr&` with graph edges
+ */
+graph::graph(
+  const vertex_ptr_vector_ptr& vertices, const edge_ptr_vector_ptr& edges)
+{
+  add_vertices(vertices);
+  add_edges(edges);
+}
+
+/**
+ * `graph` move from pointer constructor.
+ *
+ * @param vertices `vertex_ptr_vector_ptr&&` with graph vertices
+ * @param edges `edge_ptr_vector_ptr&&` with graph edges
+ */
+graph::graph(vertex_ptr_vector_ptr&& vertices, edge_ptr_vector_ptr&& edges)
+{
+  add_vertices(vertices);
+  add_edges(edges);
+}
+
+/**
+ * Return a new vector of the `graph` vertices, in order of insertion.
+ */
+vertex_ptr_vector_ptr graph::vertices() const
+{
+  return std::make_shared<vertex_ptr_vector>(vertex_list_);
+}
+
+/**
+ * Return a new vector of the `graph` edges, in order of insertion.
+ */
+edge_ptr_vector_ptr graph::edges() const
+{
+  return std::make_shared<edge_ptr_vector>(edge_list_);
+}
 
+/**
+ * Return number of vertices in the `graph`.
+ */
+std::size_t graph::n_vertices() const { return vertex_list_.size(); }
+
+/**
+ * Return number of edges in the `graph`.
+ */
+std::size_t graph::n_edges() const { return edge_list_.size(); }
+
+/**
+ * Add a vertex to the `graph` if it is not already present.
+ *
+ * @param vert `const vertex_ptr&` vertex to add
+ */
+void graph::add_vertex(const vertex_ptr& vert)
+{
+  assert(vert);
+  auto [index, inserted] = vertices_.emplace(vertex_key(vert));
+  if (inserted) {
+    assert(vertex_list_.size() < std::numeric_limits<vertex_index>::max());
+    index = static_cast<vertex_index>(vertex_list_.size());
+    vertex_list_.push_back(vert);
+  }
+}
+
+/**
+ * Add a vertex to the `graph` by move if it is not already present.
+ *
+ * @param vert `vertex_ptr&&` vertex to add
+ */
+void graph::add_vertex(vertex_ptr&& vert)
+{
+  assert(vert);
+  auto [index, inserted] = vertices_.emplace(vertex_key(vert));
+  if (inserted) {
+    assert(vertex_list_.size() < std::numeric_limits<vertex_index>::max());
+    index = static_cast<vertex_index>(vertex_list_.size());
+    vertex_list_.push_back(std::move(vert));
+  }
+}
+
+/**
+ * Add vertices to the `graph`, skipping those already present.
+ *
+ * @param vertices `const vertex_ptr_vector&` vertices to add
+ */
+void graph::add_vertices(const vertex_ptr_vector& vertices)
+{
+  vertices_.reserve(vertices_.size() + vertices.size());
+  for (const vertex_ptr& vert : vertices) {
+    add_vertex(vert);
+  }
+}
+
+/**
+ * Add vertices to the `graph`, skipping those already present.
+ *
+ * @param vertices `const vertex_ptr_vector_ptr&` vertices to add
+ */
+void graph::add_vertices(const vertex_ptr_vector_ptr& vertices)
+{
+  assert(vertices);
+  add_vertices(*vertices);
+}
+
+/**
+ * Add an edge to the `graph`, adding its vertices if necessary.
+ *
+ * An edge with the same start, end, and weight as one already in the graph
+ * is not added, as the `graph` does not hold duplicate edges.
+ *
+ * @param arc `const edge_ptr&` edge to add
+ */
+void graph::add_edge(const edge_ptr& arc)
+{
+  add_edge(edge_ptr(arc));
+}
+
+/**
+ * Add an edge to the `graph` by move, adding its vertices if necessary.
+ *
+ * @param arc `edge_ptr&&` edge to add
+ */
+void graph::add_edge(edge_ptr&& arc)
+{
+  assert(arc);
+  add_vertex(arc->start());
+  add_vertex(arc->end());
+  std::uint64_t key = edge_key(
+    *find_vertex(arc->start()), *find_vertex(arc->end())
+  );
+  auto [weights, new_pair] = edges_.emplace(key);
+  if (!weights.insert(arc->weight())) {
+    return;
+  }
+  if (new_pair && filter_) {
+    if (edges_.size() > filter_capacity_) {
+      build_edge_filter(2 * edges_.size());
+    }
+    filter_->insert(filter_key(arc->start(), arc->end()));
+  }
+  edge_list_.push_back(std::move(arc));
+}
+
+/**
+ * Add edges to the `graph`, skipping duplicates.
+ *
+ * @param edges `const edge_ptr_vector&` edges to add
+ */
+void graph::add_edges(const edge_ptr_vector& edges)
+{
+  edges_.reserve(edges_.size() + edges.size());
+  for (const edge_ptr& arc : edges) {
+    add_edge(arc);
+  }
+}
+
+/**
+ * Add edges to the `graph`, skipping duplicates.
+ *
+ * @param edges `const edge_ptr_vector_ptr&` edges to add
+ */
+void graph::add_edges(const edge_ptr_vector_ptr& edges)
+{
+  assert(edges);
+  add_edges(*edges);
+}
+
+/**
+ * Return `true` if the vertex is in the `graph`.
+ *
+ * @param vert `const vertex_ptr&` vertex to check
+ */
+bool graph::has_vertex(const vertex_ptr& vert) const
+{
+  return find_vertex(vert) != nullptr;
+}
+
+/**
+ * Return `true` if an edge equal to the given edge is in the `graph`.
+ *
+ * @param arc `const edge_ptr&` edge to check
+ */
+bool graph::has_edge(const edge_ptr& arc) const
+{
+  assert(arc);
+  return has_edge(*arc);
+}
+
+/**
+ * Return `true` if an edge equal to the given edge is in the `graph`.
+ *
+ * @param arc `edge_ptr&&` edge to check
+ */
+bool graph::has_edge(edge_ptr&& arc) const
+{
+  assert(arc);
+  return has_edge(*arc);
+}
+
+/**
+ * Return `true` if an edge equal to the given edge is in the `graph`.
+ *
+ * Edges are equal if they have the same vertex pointers and weight.
+ *
+ * @param arc `const edge&` edge to check
+ */
+bool graph::has_edge(const edge& arc) const
+{
+  const edge_weights* weights = find_weights(arc.start(), arc.end());
+  return weights && weights->contains(arc.weight());
+}
+
+/**
+ * Return `true` if an edge equal to the given edge is in the `graph`.
+ *
+ * @param arc `edge&&` edge to check
+ */
+bool graph::has_edge(edge&& arc) const
+{
+  return has_edge(static_cast<const edge&>(arc));
+}
+
+/**
+ * Determine if the `graph` has an edge between two vertices, of any weight.
+ *
+ * @param start `const vertex_ptr&` starting vertex
+ * @param end `const vertex_ptr&` ending vertex
+ * @param undirected `bool` where if `true`, the default, an edge from `end`
+ *    to `start` also counts, while if `false`, edges are treated as directed.
+ */
+bool graph::connects(
+  const vertex_ptr& start, const vertex_ptr& end, bool undirected) const
+{
+  assert(start && end);
+  return
+    find_weights(start, end) != nullptr ||
+    (undirected && find_weights(end, start) != nullptr);
+}
+
+/**
+ * Keep a blocked Bloom filter of connected vertex pairs to speed up misses.
+ *
+ * The filter is rebuilt at twice the size whenever the number of connected
+ * vertex pairs outgrows it, so insertion stays amortized constant time.
+ *
+ * @param bits_per_edge `double` filter bits per connected vertex pair, where
+ *    16 gives under 0.5% false positives
+ */
+void graph::enable_edge_filter(double bits_per_edge)
+{
+  assert(bits_per_edge > 0);
+  filter_bits_ = bits_per_edge;
+  build_edge_filter(edges_.size());
+}
+
+/**
+ * Drop the edge Bloom filter, freeing its memory.
+ */
+void graph::disable_edge_filter()
+{
+  filter_.reset();
+  filter_capacity_ = 0;
+}
+
+/**
+ * Return `true` if the `graph` keeps an edge Bloom filter.
+ */
+bool graph::has_edge_filter() const { return filter_.has_value(); }
+
+/**
+ * Return the `graph_vertex_map` key of a vertex, i.e. its address.
+ *
+ * @param vert `const vertex_ptr&` vertex
+ */
+std::uint64_t graph::vertex_key(const vertex_ptr& vert)
+{
+  return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(
+    vert.get()
+  ));
+}
+
+/**
+ * Return the `graph_edge_map` key of a vertex pair, packing both indices.
+ *
+ * @param start `vertex_index` index of the starting vertex
+ * @param end `vertex_index` index of the ending vertex
+ */
+std::uint64_t graph::edge_key(vertex_index start, vertex_index end)
+{
+  return (static_cast<std::uint64_t>(start) << 32) | end;
+}
+
+/**
+ * Return the edge Bloom filter key of a vertex pair.
+ *
+ * Hashes the pointer addresses directly, so that checking the filter does
+ * not require looking up vertex indices first.
+ *
+ * @param start `const vertex_ptr&` starting vertex
+ * @param end `const vertex_ptr&` ending vertex
+ */
+std::uint64_t graph::filter_key(const vertex_ptr& start, const vertex_ptr& end)
+{
+  return mix_hash(vertex_key(start) ^ mix_hash(vertex_key(end)));
+}
+
+/**
+ * Rebuild the edge Bloom filter from the edge list.
+ *
+ * @param capacity `std::size_t` number of vertex pairs to size the filter for
+ */
+void graph::build_edge_filter(std::size_t capacity)
+{
+  filter_capacity_ = capacity;
+  filter_.emplace(capacity, filter_bits_);
+  for (const edge_ptr& arc : edge_list_) {
+    filter_->insert(filter_key(arc->start(), arc->end()));
+  }
+}
+
+/**
+ * Return pointer to the index of a vertex, `nullptr` if not in the `graph`.
+ *
+ * @param vert `const vertex_ptr&` vertex
+ */
+const vertex_index* graph::find_vertex(const vertex_ptr& vert) const
+{
+  return vertices_.find(vertex_key(vert));
+}
+
+/**
+ * Return pointer to the weights of edges joining two vertices.
+ *
+ * @param start `const vertex_ptr&` starting vertex
+ * @param end `const vertex_ptr&` ending vertex
+ * @returns `const edge_weights*`, `nullptr` if there is no such edge
+ */
+const edge_weights* graph::find_weights(
+  const vertex_ptr& start, const vertex_ptr& end) const
+{
+  if (filter_ && !filter_->contains(filter_key(start, end))) {
+    return nullptr;
+  }
+  const vertex_index* start_index = find_vertex(start);
+  if (!start_index) {
+    return nullptr;
+  }
+  const vertex_index* end_index = find_vertex(end);
+  if (!end_index) {
+    return nullptr;
+  }
+  return edges_.find(edge_key(*start_index, *end_index));
 }
-*/
 
 }  // namespace pdcip
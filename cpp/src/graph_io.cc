@@ -0,0 +1,586 @@
+/**
+ * @file graph_io.cc
+ * @author Derek Huang
+ * @brief C++ source for loading graphs from text files
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/graph_io.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/mapped_file.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Largest vertex index a file may reference.
+ */
+constexpr std::uint64_t max_vertex = std::numeric_limits<vertex_index>::max();
+
+/**
+ * Exactly representable powers of ten for the fast float parsing path.
+ */
+constexpr double exact_powers[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * Return `true` if a character separates tokens within a line.
+ *
+ * @param c `char` character to check
+ */
+inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/**
+ * Return pointer to the first non-blank character in `[p, end)`.
+ *
+ * @param p `const char*` start of range
+ * @param end `const char*` end of range
+ */
+inline const char* skip_blanks(const char* p, const char* end)
+{
+  while (p < end && is_blank(*p)) {
+    p++;
+  }
+  return p;
+}
+
+/**
+ * Parse an unsigned decimal integer, advancing `p` past it.
+ *
+ * @param p `const char*&` parse position, advanced on success
+ * @param end `const char*` end of line
+ * @param value `std::uint64_t&` parsed value
+ * @returns `true` if at least one digit was read without overflow
+ */
+bool parse_index(const char*& p, const char* end, std::uint64_t& value)
+{
+  const char* start = p;
+  value = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    value = 10 * value + static_cast<std::uint64_t>(*p - '0');
+    if (value > max_vertex + 1) {
+      return false;
+    }
+    p++;
+  }
+  return p != start;
+}
+
+/**
+ * Parse a decimal floating point number, advancing `p` past it.
+ *
+ * Numbers with at most 15 significant digits and a decimal exponent of at
+ * most 22 in magnitude are converted exactly with one multiply or divide,
+ * which covers nearly every weight found in practice. Anything else, such
+ * as `inf` or long mantissas, falls back to `std::strtod`.
+ *
+ * @param p `const char*&` parse position, advanced on success
+ * @param end `const char*` end of line
+ * @param value `double&` parsed value
+ * @returns `true` on success
+ */
+bool parse_real(const char*& p, const char* end, double& value)
+{
+  const char* start = p;
+  bool negative = false;
+  if (p < end && (*p == '+' || *p == '-')) {
+    negative = (*p == '-');
+    p++;
+  }
+  std::uint64_t mantissa = 0;
+  int n_digits = 0;
+  int exponent = 0;
+  bool seen_digit = false;
+  // leading zeros are not significant
+  while (p < end && *p == '0') {
+    seen_digit = true;
+    p++;
+  }
+  for (; p < end && *p >= '0' && *p <= '9'; p++) {
+    seen_digit = true;
+    if (n_digits < 19) {
+      mantissa = 10 * mantissa + static_cast<std::uint64_t>(*p - '0');
+      n_digits++;
+    }
+    else {
+      exponent++;
+      n_digits++;
+    }
+  }
+  if (p < end && *p == '.') {
+    p++;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+      seen_digit = true;
+      if (!mantissa && *p == '0') {
+        exponent--;
+      }
+      else if (n_digits < 19) {
+        mantissa = 10 * mantissa + static_cast<std::uint64_t>(*p - '0');
+        exponent--;
+        n_digits++;
+      }
+      else {
+        n_digits++;
+      }
+    }
+  }
+  if (seen_digit && p < end && (*p == 'e' || *p == 'E')) {
+    const char* exp_start = p++;
+    bool exp_negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+      exp_negative = (*p == '-');
+      p++;
+    }
+    int exp_value = 0;
+    const char* exp_digits = p;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+      exp_value = std::min(10 * exp_value + (*p - '0'), 100000);
+    }
+    if (p == exp_digits) {
+      p = exp_start;
+    }
+    else {
+      exponent += (exp_negative) ? -exp_value : exp_value;
+    }
+  }
+  if (
+    seen_digit && n_digits <= 15 && exponent >= -22 && exponent <= 22 &&
+    (p == end || is_blank(*p))
+  ) {
+    value = static_cast<double>(mantissa);
+    value = (exponent < 0) ?
+      value / exact_powers[-exponent] : value * exact_powers[exponent];
+    value = (negative) ? -value : value;
+    return true;
+  }
+  // slow path needs a null-terminated copy of the whole token
+  p = start;
+  while (p < end && !is_blank(*p)) {
+    p++;
+  }
+  std::string token(start, p);
+  char* token_end;
+  value = std::strtod(token.c_str(), &token_end);
+  return !token.empty() && token_end == token.c_str() + token.size();
+}
+
+/**
+ * Split `[first, last)` into up to `n_chunks` ranges of whole lines.
+ *
+ * @param first `const char*` start of text
+ * @param last `const char*` end of text
+ * @param n_chunks `std::size_t` number of chunks wanted
+ * @returns `std::vector<const char*>` of chunk boundaries, first and last
+ *    included, with empty chunks removed
+ */
+std::vector<const char*> split_lines(
+  const char* first, const char* last, std::size_t n_chunks)
+{
+  std::vector<const char*> bounds{first};
+  std::size_t size = static_cast<std::size_t>(last - first);
+  for (std::size_t i = 1; i < n_chunks; i++) {
+    const char* p = std::max(first + i * size / n_chunks, bounds.back());
+    if (p == last) {
+      break;
+    }
+    const void* newline = std::memchr(
+      p, '\n', static_cast<std::size_t>(last - p)
+    );
+    p = (newline) ? static_cast<const char*>(newline) + 1 : last;
+    if (p != bounds.back() && p != last) {
+      bounds.push_back(p);
+    }
+  }
+  bounds.push_back(last);
+  return bounds;
+}
+
+/**
+ * Edges parsed from one chunk of a file.
+ */
+struct edge_chunk {
+  vertex_index_vector sources;
+  vertex_index_vector targets;
+  double_vector weights;
+  std::size_t n_entries = 0;
+  std::uint64_t n_vertices = 0;
+  bool weighted = false;
+  bool valid = true;
+};
+
+/**
+ * Parse the lines of a text buffer into edges across threads.
+ *
+ * The buffer is cut into one chunk of whole lines per thread and each chunk
+ * is parsed into its own `edge_chunk`, which are then concatenated in
+ * parallel. Blank lines and lines starting with `#` or `%` are skipped.
+ *
+ * @tparam F callable with signature `bool(const char*, const char*,
+ *    edge_chunk&)` that parses one nonempty line
+ * @param first `const char*` start of text
+ * @param last `const char*` end of text
+ * @param parse_line `const F&` line parser, returning `false` on bad input
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns merged `edge_chunk`, with `valid` false if any line was bad
+ */
+template <typename F>
+edge_chunk parse_lines(
+  const char* first,
+  const char* last,
+  const F& parse_line,
+  std::size_t n_threads)
+{
+  std::vector<const char*> bounds = split_lines(
+    first, last, resolve_n_threads(n_threads)
+  );
+  std::vector<edge_chunk> chunks(bounds.size() - 1);
+  parallel_run(
+    chunks.size(),
+    [&](std::size_t chunk_id)
+    {
+      edge_chunk& chunk = chunks[chunk_id];
+      const char* p = bounds[chunk_id];
+      const char* end = bounds[chunk_id + 1];
+      while (p < end && chunk.valid) {
+        const void* newline = std::memchr(
+          p, '\n', static_cast<std::size_t>(end - p)
+        );
+        const char* line_end = (newline) ?
+          static_cast<const char*>(newline) : end;
+        const char* q = skip_blanks(p, line_end);
+        if (q != line_end && *q != '#' && *q != '%') {
+          chunk.valid = parse_line(q, line_end, chunk);
+        }
+        p = line_end + 1;
+      }
+    }
+  );
+  edge_chunk result;
+  std::vector<std::size_t> offsets{0};
+  for (const edge_chunk& chunk : chunks) {
+    result.n_entries += chunk.n_entries;
+    result.n_vertices = std::max(result.n_vertices, chunk.n_vertices);
+    result.weighted |= chunk.weighted;
+    result.valid &= chunk.valid;
+    offsets.push_back(offsets.back() + chunk.sources.size());
+  }
+  if (!result.valid) {
+    return result;
+  }
+  result.sources.resize(offsets.back());
+  result.targets.resize(offsets.back());
+  result.weights.resize((result.weighted) ? offsets.back() : 0);
+  parallel_run(
+    chunks.size(),
+    [&](std::size_t chunk_id)
+    {
+      edge_chunk& chunk = chunks[chunk_id];
+      std::size_t offset = offsets[chunk_id];
+      std::copy(
+        chunk.sources.begin(),
+        chunk.sources.end(),
+        result.sources.begin() + offset
+      );
+      std::copy(
+        chunk.targets.begin(),
+        chunk.targets.end(),
+        result.targets.begin() + offset
+      );
+      if (result.weighted) {
+        std::copy(
+          chunk.weights.begin(),
+          chunk.weights.end(),
+          result.weights.begin() + offset
+        );
+      }
+      chunk = edge_chunk();
+    }
+  );
+  return result;
+}
+
+/**
+ * Read one token from a line, lowercased.
+ *
+ * @param p `const char*&` parse position, advanced past the token
+ * @param end `const char*` end of line
+ */
+std::string read_token(const char*& p, const char* end)
+{
+  p = skip_blanks(p, end);
+  std::string token;
+  for (; p < end && !is_blank(*p); p++) {
+    token.push_back(static_cast<char>(std::tolower(*p)));
+  }
+  return token;
+}
+
+/**
+ * Run a parser over a memory-mapped file.
+ *
+ * @param path `const std::string&` path of the file to read
+ * @param parse parser taking a buffer, its size, and a thread count
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+template <typename F>
+std::optional<csr_graph> read_mapped(
+  const std::string& path, const F& parse, std::size_t n_threads)
+{
+  mapped_file file(path);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+  return parse(file.data(), file.size(), n_threads);
+}
+
+}  // namespace
+
+/**
+ * Parse a whitespace-separated edge list into a CSR graph.
+ *
+ * Each line holds a zero-based source and target index and an optional
+ * weight. If any line has a weight, lines without one get weight `1`. Blank
+ * lines and lines starting with `#` or `%` are skipped. The vertex count is
+ * one past the largest index seen.
+ *
+ * The text is split into one chunk of whole lines per thread, parsed with
+ * hand-rolled number parsing, and the edges go straight into the counting
+ * sort that builds the CSR arrays.
+ *
+ * @param data `const char*` text to parse, need not be null-terminated
+ * @param size `std::size_t` number of bytes of text
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::optional<csr_graph>`, empty on malformed input
+ */
+std::optional<csr_graph> parse_edge_list(
+  const char* data, std::size_t size, std::size_t n_threads)
+{
+  edge_chunk edges = parse_lines(
+    data,
+    data + size,
+    [](const char* p, const char* end, edge_chunk& chunk)
+    {
+      std::uint64_t source;
+      std::uint64_t target;
+      double weight = 1;
+      if (!parse_index(p, end, source) || p == end || !is_blank(*p)) {
+        return false;
+      }
+      p = skip_blanks(p, end);
+      if (!parse_index(p, end, target)) {
+        return false;
+      }
+      p = skip_blanks(p, end);
+      if (p != end) {
+        if (!parse_real(p, end, weight)) {
+          return false;
+        }
+        chunk.weighted = true;
+        p = skip_blanks(p, end);
+      }
+      if (p != end || source >= max_vertex || target >= max_vertex) {
+        return false;
+      }
+      chunk.sources.push_back(static_cast<vertex_index>(source));
+      chunk.targets.push_back(static_cast<vertex_index>(target));
+      chunk.weights.push_back(weight);
+      chunk.n_entries++;
+      chunk.n_vertices = std::max({chunk.n_vertices, source + 1, target + 1});
+      return true;
+    },
+    n_threads
+  );
+  if (!edges.valid) {
+    return std::nullopt;
+  }
+  return csr_graph(
+    static_cast<std::size_t>(edges.n_vertices),
+    edges.sources,
+    edges.targets,
+    edges.weights
+  );
+}
+
+/**
+ * Parse a Matrix Market coordinate file into a CSR graph.
+ *
+ * Entry `(i, j)` becomes an edge from vertex `i - 1` to vertex `j - 1` and the
+ * vertex count is the larger matrix dimension. `real` and `integer` values
+ * become weights and `pattern` files are unweighted. For `symmetric` and
+ * `skew-symmetric` files each off-diagonal entry is mirrored, negating the
+ * weight of the mirror in the skew case. `complex` and `hermitian` files are
+ * not supported.
+ *
+ * The entries are split across threads the same way as `parse_edge_list`.
+ *
+ * @param data `const char*` text to parse, need not be null-terminated
+ * @param size `std::size_t` number of bytes of text
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::optional<csr_graph>`, empty on malformed input or if the
+ *    number of entries does not match the size line
+ */
+std::optional<csr_graph> parse_matrix_market(
+  const char* data, std::size_t size, std::size_t n_threads)
+{
+  if (!size) {
+    return std::nullopt;
+  }
+  const char* p = data;
+  const char* last = data + size;
+  // returns the end of the line starting at p
+  auto line_end = [&]
+  {
+    const void* newline = std::memchr(
+      p, '\n', static_cast<std::size_t>(last - p)
+    );
+    return (newline) ? static_cast<const char*>(newline) : last;
+  };
+  const char* end = line_end();
+  if (
+    read_token(p, end) != "%%matrixmarket" ||
+    read_token(p, end) != "matrix" ||
+    read_token(p, end) != "coordinate"
+  ) {
+    return std::nullopt;
+  }
+  std::string field = read_token(p, end);
+  std::string symmetry = read_token(p, end);
+  bool weighted = (field == "real" || field == "integer");
+  bool skew = (symmetry == "skew-symmetric");
+  bool mirror = (skew || symmetry == "symmetric");
+  if (
+    (!weighted && field != "pattern") || (!mirror && symmetry != "general")
+  ) {
+    return std::nullopt;
+  }
+  // skip comments up to the size line
+  std::uint64_t dims[3];
+  while (true) {
+    if (end == last) {
+      return std::nullopt;
+    }
+    p = end + 1;
+    end = line_end();
+    p = skip_blanks(p, end);
+    if (p != end && *p != '%') {
+      break;
+    }
+  }
+  for (std::uint64_t& dim : dims) {
+    p = skip_blanks(p, end);
+    if (!parse_index(p, end, dim)) {
+      return std::nullopt;
+    }
+  }
+  std::uint64_t n_rows = dims[0];
+  std::uint64_t n_cols = dims[1];
+  std::uint64_t n_vertices = std::max(n_rows, n_cols);
+  if (skip_blanks(p, end) != end || n_vertices > max_vertex) {
+    return std::nullopt;
+  }
+  p = std::min(end + 1, last);
+  edge_chunk edges = parse_lines(
+    p,
+    last,
+    [&](const char* q, const char* q_end, edge_chunk& chunk)
+    {
+      std::uint64_t row;
+      std::uint64_t col;
+      double weight = 1;
+      if (!parse_index(q, q_end, row) || q == q_end || !is_blank(*q)) {
+        return false;
+      }
+      q = skip_blanks(q, q_end);
+      if (!parse_index(q, q_end, col)) {
+        return false;
+      }
+      q = skip_blanks(q, q_end);
+      if (weighted && !parse_real(q, q_end, weight)) {
+        return false;
+      }
+      q = skip_blanks(q, q_end);
+      if (q != q_end || !row || !col || row > n_rows || col > n_cols) {
+        return false;
+      }
+      vertex_index source = static_cast<vertex_index>(row - 1);
+      vertex_index target = static_cast<vertex_index>(col - 1);
+      chunk.sources.push_back(source);
+      chunk.targets.push_back(target);
+      chunk.weights.push_back(weight);
+      if (mirror && source != target) {
+        chunk.sources.push_back(target);
+        chunk.targets.push_back(source);
+        chunk.weights.push_back((skew) ? -weight : weight);
+      }
+      chunk.weighted = weighted;
+      chunk.n_entries++;
+      return true;
+    },
+    n_threads
+  );
+  if (!edges.valid || edges.n_entries != dims[2]) {
+    return std::nullopt;
+  }
+  if (!weighted) {
+    edges.weights.clear();
+  }
+  return csr_graph(
+    static_cast<std::size_t>(n_vertices),
+    edges.sources,
+    edges.targets,
+    edges.weights
+  );
+}
+
+/**
+ * Load a whitespace-separated edge list file into a CSR graph.
+ *
+ * The file is memory-mapped rather than streamed, so threads can parse
+ * disjoint chunks directly out of the page cache. See `parse_edge_list`.
+ *
+ * @param path `const std::string&` path of the file to read
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::optional<csr_graph>`, empty if the file could not be
+ *    mapped or is malformed
+ */
+std::optional<csr_graph> read_edge_list(
+  const std::string& path, std::size_t n_threads)
+{
+  return read_mapped(path, parse_edge_list, n_threads);
+}
+
+/**
+ * Load a Matrix Market coordinate file into a CSR graph.
+ *
+ * The file is memory-mapped rather than streamed, so threads can parse
+ * disjoint chunks directly out of the page cache. See `parse_matrix_market`.
+ *
+ * @param path `const std::string&` path of the file to read
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::optional<csr_graph>`, empty if the file could not be
+ *    mapped or is malformed
+ */
+std::optional<csr_graph> read_matrix_market(
+  const std::string& path, std::size_t n_threads)
+{
+  return read_mapped(path, parse_matrix_market, n_threads);
+}
+
+}  // namespace pdcip
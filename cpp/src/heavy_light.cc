@@ -0,0 +1,294 @@
+/**
+ * @file heavy_light.cc
+ * @author Derek Huang
+ * @brief C++ source for heavy-light decomposition of trees
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/heavy_light.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Marker for a node without a heavy child, i.e. a leaf.
+ */
+constexpr vertex_index no_child = std::numeric_limits<vertex_index>::max();
+
+/**
+ * Return the aggregate of two disjoint sets of values.
+ *
+ * @param first `const path_aggregate&` first aggregate
+ * @param second `const path_aggregate&` second aggregate
+ */
+path_aggregate combine(
+  const path_aggregate& first, const path_aggregate& second)
+{
+  return {
+    first.sum + second.sum,
+    std::min(first.min, second.min),
+    std::max(first.max, second.max)
+  };
+}
+
+}  // namespace
+
+/**
+ * `heavy_light` constructor.
+ *
+ * Uses two iterative passes, one to size subtrees and pick heavy children
+ * and one to number nodes heavy child first, so deep trees cannot overflow
+ * the call stack. `nullptr` children, e.g. missing `binary_tree` children,
+ * are skipped.
+ *
+ * @param root `const tree_ptr&` root of the tree
+ */
+heavy_light::heavy_light(const tree_ptr& root)
+{
+  assert(root);
+  // breadth-first order, which puts parents before their children and keeps
+  // the children of each node contiguous
+  tree_ptr_vector order{root};
+  vertex_index_vector order_parents{0};
+  for (std::size_t i = 0; i < order.size(); i++) {
+    const tree_ptr_vector_ptr& children = order[i]->children();
+    if (!children) {
+      continue;
+    }
+    for (const tree_ptr& child : *children) {
+      if (child) {
+        order.push_back(child);
+        order_parents.push_back(static_cast<vertex_index>(i));
+      }
+    }
+  }
+  std::size_t n_nodes = order.size();
+  std::vector<std::size_t> sizes(n_nodes, 1);
+  vertex_index_vector heavy(n_nodes, no_child);
+  for (std::size_t i = n_nodes; i-- > 1; ) {
+    sizes[order_parents[i]] += sizes[i];
+  }
+  vertex_index_vector child_begin(n_nodes + 1, 0);
+  for (std::size_t i = 1; i < n_nodes; i++) {
+    vertex_index p = order_parents[i];
+    if (heavy[p] == no_child || sizes[i] > sizes[heavy[p]]) {
+      heavy[p] = static_cast<vertex_index>(i);
+    }
+    child_begin[p + 1]++;
+  }
+  child_begin[0] = 1;
+  for (std::size_t i = 0; i < n_nodes; i++) {
+    child_begin[i + 1] += child_begin[i];
+  }
+  // number nodes depth-first, visiting the heavy child right after its
+  // parent so that each heavy path gets a contiguous range of positions
+  vertex_index_vector positions(n_nodes);
+  vertex_index_vector order_heads(n_nodes);
+  vertex_index_vector stack{0};
+  vertex_index next = 0;
+  while (!stack.empty()) {
+    vertex_index v = stack.back();
+    stack.pop_back();
+    positions[v] = next++;
+    vertex_index p = order_parents[v];
+    order_heads[v] = (v && heavy[p] == v) ? order_heads[p] : v;
+    for (vertex_index c = child_begin[v]; c < child_begin[v + 1]; c++) {
+      if (c != heavy[v]) {
+        stack.push_back(c);
+      }
+    }
+    if (heavy[v] != no_child) {
+      stack.push_back(heavy[v]);
+    }
+  }
+  nodes_.resize(n_nodes);
+  parents_.resize(n_nodes);
+  depths_.resize(n_nodes);
+  heads_.resize(n_nodes);
+  segments_.resize(2 * n_nodes);
+  for (std::size_t i = 0; i < n_nodes; i++) {
+    vertex_index pos = positions[i];
+    nodes_[pos] = std::move(order[i]);
+    parents_[pos] = positions[order_parents[i]];
+    heads_[pos] = positions[order_heads[i]];
+    double value = nodes_[pos]->value();
+    segments_[n_nodes + pos] = {value, value, value};
+    auto slot = indices_.emplace(node_key(nodes_[pos].get()));
+    assert(slot.second && "tree nodes must not be shared");
+    slot.first = pos;
+  }
+  for (std::size_t i = 1; i < n_nodes; i++) {
+    depths_[positions[i]] = depths_[positions[order_parents[i]]] + 1;
+  }
+  for (std::size_t i = n_nodes; i-- > 1; ) {
+    segments_[i] = combine(segments_[2 * i], segments_[2 * i + 1]);
+  }
+}
+
+/**
+ * Return number of nodes in the tree.
+ */
+std::size_t heavy_light::n_nodes() const { return nodes_.size(); }
+
+/**
+ * Return the position of a tree node in the decomposition.
+ *
+ * @param node `const tree_ptr&` node of the decomposed tree
+ */
+vertex_index heavy_light::index(const tree_ptr& node) const
+{
+  const vertex_index* pos = indices_.find(node_key(node.get()));
+  assert(pos && "node is not in the tree");
+  return *pos;
+}
+
+/**
+ * Return the tree node at a given position.
+ *
+ * @param v `vertex_index` node position
+ */
+const tree_ptr& heavy_light::node(vertex_index v) const { return nodes_[v]; }
+
+/**
+ * Return the position of a node's parent, the root being its own parent.
+ *
+ * @param v `vertex_index` node position
+ */
+vertex_index heavy_light::parent(vertex_index v) const { return parents_[v]; }
+
+/**
+ * Return the depth of a node, the root having depth zero.
+ *
+ * @param v `vertex_index` node position
+ */
+vertex_index heavy_light::depth(vertex_index v) const { return depths_[v]; }
+
+/**
+ * Return the position of the top node of a node's heavy path.
+ *
+ * @param v `vertex_index` node position
+ */
+vertex_index heavy_light::head(vertex_index v) const { return heads_[v]; }
+
+/**
+ * Return the value of a node as last seen by the decomposition.
+ *
+ * @param v `vertex_index` node position
+ */
+double heavy_light::value(vertex_index v) const
+{
+  return segments_[nodes_.size() + v].sum;
+}
+
+/**
+ * Set the value of a node, updating the tree node and the segment tree.
+ *
+ * @param v `vertex_index` node position
+ * @param value `double` new node value
+ */
+void heavy_light::set_value(vertex_index v, double value)
+{
+  nodes_[v]->set_value(value);
+  std::size_t i = nodes_.size() + v;
+  segments_[i] = {value, value, value};
+  for (i /= 2; i; i /= 2) {
+    segments_[i] = combine(segments_[2 * i], segments_[2 * i + 1]);
+  }
+}
+
+/**
+ * Return the aggregate of node values on the path between two nodes.
+ *
+ * Both endpoints and their lowest common ancestor are included.
+ *
+ * @param u `vertex_index` first node position
+ * @param v `vertex_index` second node position
+ */
+path_aggregate heavy_light::query_path(vertex_index u, vertex_index v) const
+{
+  path_aggregate result;
+  // lift whichever endpoint has the deeper path head until both share one
+  while (heads_[u] != heads_[v]) {
+    if (depths_[heads_[u]] < depths_[heads_[v]]) {
+      std::swap(u, v);
+    }
+    result = combine(result, query_range(heads_[u], u + 1));
+    u = parents_[heads_[u]];
+  }
+  return combine(result, query_range(std::min(u, v), std::max(u, v) + 1));
+}
+
+/**
+ * Return the sum of node values on the path between two nodes.
+ *
+ * @param u `vertex_index` first node position
+ * @param v `vertex_index` second node position
+ */
+double heavy_light::path_sum(vertex_index u, vertex_index v) const
+{
+  return query_path(u, v).sum;
+}
+
+/**
+ * Return the smallest node value on the path between two nodes.
+ *
+ * @param u `vertex_index` first node position
+ * @param v `vertex_index` second node position
+ */
+double heavy_light::path_min(vertex_index u, vertex_index v) const
+{
+  return query_path(u, v).min;
+}
+
+/**
+ * Return the largest node value on the path between two nodes.
+ *
+ * @param u `vertex_index` first node position
+ * @param v `vertex_index` second node position
+ */
+double heavy_light::path_max(vertex_index u, vertex_index v) const
+{
+  return query_path(u, v).max;
+}
+
+/**
+ * Return the aggregate of values at positions `[begin, end)`.
+ *
+ * Walks the bottom-up segment tree from both ends of the range towards the
+ * root. All three aggregates are commutative, so the tree need not have a
+ * power-of-two size.
+ *
+ * @param begin `std::size_t` first position
+ * @param end `std::size_t` one past the last position
+ */
+path_aggregate heavy_light::query_range(
+  std::size_t begin, std::size_t end) const
+{
+  path_aggregate result;
+  for (begin += nodes_.size(), end += nodes_.size(); begin < end; ) {
+    if (begin & 1) {
+      result = combine(result, segments_[begin++]);
+    }
+    if (end & 1) {
+      result = combine(result, segments_[--end]);
+    }
+    begin /= 2;
+    end /= 2;
+  }
+  return result;
+}
+
+}  // namespace pdcip
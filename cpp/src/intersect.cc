@@ -0,0 +1,125 @@
+/**
+ * @file intersect.cc
+ * @author Derek Huang
+ * @brief C++ source for sorted set intersection kernels
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/intersect.h"
+
+#include <cstddef>
+
+// SSE2 is part of the x86-64 baseline, so no extra compiler flags are needed
+#if defined(__SSE2__) || defined(_M_X64)
+#define PDCIP_CPP_INTERSECT_SSE2
+#include <emmintrin.h>
+#endif  // defined(__SSE2__) || defined(_M_X64)
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Intersect two sorted lists of unique vertex indices, one at a time.
+ *
+ * @param a_begin `const vertex_index*` start of first list
+ * @param a_end `const vertex_index*` end of first list
+ * @param b_begin `const vertex_index*` start of second list
+ * @param b_end `const vertex_index*` end of second list
+ * @param out `vertex_index*` buffer to write common elements to in ascending
+ *    order, or `nullptr` to only count them
+ * @returns `std::size_t` number of common elements
+ */
+std::size_t intersect_sorted_scalar(
+  const vertex_index* a_begin,
+  const vertex_index* a_end,
+  const vertex_index* b_begin,
+  const vertex_index* b_end,
+  vertex_index* out)
+{
+  std::size_t count = 0;
+  while (a_begin != a_end && b_begin != b_end) {
+    if (*a_begin < *b_begin) {
+      a_begin++;
+    }
+    else if (*b_begin < *a_begin) {
+      b_begin++;
+    }
+    else {
+      if (out) {
+        out[count] = *a_begin;
+      }
+      count++;
+      a_begin++;
+      b_begin++;
+    }
+  }
+  return count;
+}
+
+/**
+ * Intersect two sorted lists of unique vertex indices.
+ *
+ * On x86-64 the lists are consumed four elements at a time: each block of
+ * `a` is compared against all four rotations of the current block of `b` with
+ * SSE2, giving a 4-lane match mask in four compares, and whichever block has
+ * the smaller maximum is advanced. The tails are finished by the scalar
+ * kernel, which is also used everywhere else.
+ *
+ * @param a_begin `const vertex_index*` start of first list
+ * @param a_end `const vertex_index*` end of first list
+ * @param b_begin `const vertex_index*` start of second list
+ * @param b_end `const vertex_index*` end of second list
+ * @param out `vertex_index*` buffer to write common elements to in ascending
+ *    order, or `nullptr` to only count them
+ * @returns `std::size_t` number of common elements
+ */
+std::size_t intersect_sorted(
+  const vertex_index* a_begin,
+  const vertex_index* a_end,
+  const vertex_index* b_begin,
+  const vertex_index* b_end,
+  vertex_index* out)
+{
+  std::size_t count = 0;
+#ifdef PDCIP_CPP_INTERSECT_SSE2
+  while (a_end - a_begin >= 4 && b_end - b_begin >= 4) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_begin));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b_begin));
+    __m128i matches = _mm_or_si128(
+      _mm_or_si128(
+        _mm_cmpeq_epi32(a, b),
+        _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1)))
+      ),
+      _mm_or_si128(
+        _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))),
+        _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3)))
+      )
+    );
+    auto mask = static_cast<unsigned>(
+      _mm_movemask_ps(_mm_castsi128_ps(matches))
+    );
+    for (unsigned lane = 0; mask; lane++, mask >>= 1) {
+      if (mask & 1) {
+        if (out) {
+          out[count] = a_begin[lane];
+        }
+        count++;
+      }
+    }
+    vertex_index a_max = a_begin[3];
+    vertex_index b_max = b_begin[3];
+    if (a_max <= b_max) {
+      a_begin += 4;
+    }
+    if (b_max <= a_max) {
+      b_begin += 4;
+    }
+  }
+#endif  // PDCIP_CPP_INTERSECT_SSE2
+  return count + intersect_sorted_scalar(
+    a_begin, a_end, b_begin, b_end, (out) ? out + count : nullptr
+  );
+}
+
+}  // namespace pdcip
@@ -0,0 +1,139 @@
+/**
+ * @file interval_tree.cc
+ * @author Derek Huang
+ * @brief C++ source for a static augmented interval tree
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/interval_tree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * `interval_tree` constructor.
+ *
+ * Sorts the intervals by start and pads them to `2^h - 1` entries with empty
+ * intervals starting at infinity, which keeps the implicit tree perfect so
+ * that every node has both children. Runs in `O(n log n)`.
+ *
+ * @param intervals `const std::vector<double_pair>&` closed intervals given
+ *    as `(start, end)` pairs, reported by their position in this vector
+ */
+interval_tree::interval_tree(const std::vector<double_pair>& intervals)
+  : n_intervals_(intervals.size()), height_(0)
+{
+  while ((std::size_t(1) << height_) - 1 < n_intervals_) {
+    height_++;
+  }
+  std::size_t n_slots = (std::size_t(1) << height_) - 1;
+  std::vector<std::size_t> order(n_intervals_);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(
+    order.begin(),
+    order.end(),
+    [&](std::size_t a, std::size_t b)
+    {
+      return intervals[a].first < intervals[b].first;
+    }
+  );
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  starts_.assign(n_slots, inf);
+  ends_.assign(n_slots, -inf);
+  ids_.assign(n_slots, 0);
+  for (std::size_t i = 0; i < n_intervals_; i++) {
+    assert(intervals[order[i]].first <= intervals[order[i]].second);
+    starts_[i] = intervals[order[i]].first;
+    ends_[i] = intervals[order[i]].second;
+    ids_[i] = order[i];
+  }
+  // leaves are the even slots, and each level up halves the node count
+  max_ends_ = ends_;
+  for (std::size_t level = 1; level < height_; level++) {
+    std::size_t half = std::size_t(1) << (level - 1);
+    for (std::size_t i = 2 * half - 1; i < n_slots; i += 4 * half) {
+      max_ends_[i] = std::max(
+        {ends_[i], max_ends_[i - half], max_ends_[i + half]}
+      );
+    }
+  }
+}
+
+/**
+ * Return number of intervals.
+ */
+std::size_t interval_tree::size() const { return n_intervals_; }
+
+/**
+ * Report every interval containing a point.
+ *
+ * @param point `double` point to stab with
+ * @param out `std::vector<std::size_t>&` buffer the positions of the
+ *    matching intervals are appended to, in no particular order
+ * @returns `std::size_t` number of matching intervals
+ */
+std::size_t interval_tree::stab(
+  double point, std::vector<std::size_t>& out) const
+{
+  return overlap(point, point, out);
+}
+
+/**
+ * Report every interval overlapping the closed interval `[low, high]`.
+ *
+ * @param low `double` start of the query interval
+ * @param high `double` end of the query interval
+ * @param out `std::vector<std::size_t>&` buffer the positions of the
+ *    matching intervals are appended to, in no particular order
+ * @returns `std::size_t` number of matching intervals
+ */
+std::size_t interval_tree::overlap(
+  double low, double high, std::vector<std::size_t>& out) const
+{
+  std::size_t n_found = out.size();
+  if (!height_) {
+    return 0;
+  }
+  // each level leaves at most one node on the stack besides the one visited
+  std::pair<std::size_t, std::size_t> stack[2 * 64];
+  std::size_t top = 0;
+  stack[top++] = {(std::size_t(1) << (height_ - 1)) - 1, height_ - 1};
+  while (top) {
+    auto [i, level] = stack[--top];
+    // skip subtrees ending before the query or starting after it, the
+    // smallest start of a subtree being at the start of its range
+    std::size_t first = i + 1 - (std::size_t(1) << level);
+    if (max_ends_[i] < low || starts_[first] > high) {
+      continue;
+    }
+    // padding slots come after every real interval
+    bool real = i < n_intervals_;
+    if (!level) {
+      if (real && starts_[i] <= high) {
+        out.push_back(ids_[i]);
+      }
+      continue;
+    }
+    std::size_t half = std::size_t(1) << (level - 1);
+    stack[top++] = {i - half, level - 1};
+    // the right subtree starts no earlier than this node
+    if (starts_[i] <= high) {
+      if (real && ends_[i] >= low) {
+        out.push_back(ids_[i]);
+      }
+      stack[top++] = {i + half, level - 1};
+    }
+  }
+  return out.size() - n_found;
+}
+
+}  // namespace pdcip
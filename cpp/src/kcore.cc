@@ -0,0 +1,239 @@
+/**
+ * @file kcore.cc
+ * @author Derek Huang
+ * @brief C++ source for k-core decomposition
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/kcore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Return the degree of a vertex, not counting self-loops.
+ *
+ * @param graph `const csr_graph&` symmetric graph
+ * @param vert `vertex_index` vertex to get degree of
+ */
+vertex_index loopless_degree(const csr_graph& graph, vertex_index vert)
+{
+  return static_cast<vertex_index>(
+    graph.degree(vert) - graph.has_edge(vert, vert)
+  );
+}
+
+}  // namespace
+
+/**
+ * Peel a graph with Batagelj-Zaversnik bucket peeling.
+ *
+ * Vertices are kept bucket-sorted by current degree in one flat array, with
+ * `bins[d]` marking where the degree `d` bucket starts. Peeling the vertex of
+ * smallest degree and moving each higher-degree neighbor one bucket down is
+ * a constant-time swap, so the whole peeling runs in `O(V + E)`. The array
+ * ends up holding the removal order, and the degrees the core numbers.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *    Self-loops are ignored.
+ *
+ * @param graph `const csr_graph&` undirected graph
+ */
+degeneracy_peeling peel_by_degree(const csr_graph& graph)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  vertex_index_vector degrees(n_vertices);
+  vertex_index max_degree = 0;
+  for (vertex_index v = 0; v < n_vertices; v++) {
+    degrees[v] = loopless_degree(graph, v);
+    max_degree = std::max(max_degree, degrees[v]);
+  }
+  // counting sort of vertices by degree
+  vertex_index_vector bins(max_degree + 2, 0);
+  for (vertex_index degree : degrees) {
+    bins[degree + 1]++;
+  }
+  for (std::size_t d = 0; d <= max_degree; d++) {
+    bins[d + 1] += bins[d];
+  }
+  vertex_index_vector sorted(n_vertices);
+  vertex_index_vector positions(n_vertices);
+  {
+    vertex_index_vector next(bins.begin(), bins.end() - 1);
+    for (vertex_index v = 0; v < n_vertices; v++) {
+      positions[v] = next[degrees[v]]++;
+      sorted[positions[v]] = v;
+    }
+  }
+  for (std::size_t i = 0; i < n_vertices; i++) {
+    vertex_index v = sorted[i];
+    graph.for_each_neighbor(
+      v,
+      [&](vertex_index u, edge_index)
+      {
+        if (degrees[u] <= degrees[v]) {
+          return;
+        }
+        // swap u with the first vertex of its bucket, then shrink the bucket
+        vertex_index u_degree = degrees[u];
+        vertex_index first = sorted[bins[u_degree]];
+        if (first != u) {
+          std::swap(sorted[positions[u]], sorted[bins[u_degree]]);
+          std::swap(positions[u], positions[first]);
+        }
+        bins[u_degree]++;
+        degrees[u]--;
+      }
+    );
+  }
+  return {std::move(sorted), std::move(degrees)};
+}
+
+/**
+ * Compute the core number of every vertex with Batagelj-Zaversnik peeling.
+ *
+ * Runs in `O(V + E)`, see `peel_by_degree`.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *    Self-loops are ignored.
+ *
+ * @param graph `const csr_graph&` undirected graph
+ * @returns `vertex_index_vector` giving the core number of each vertex
+ */
+vertex_index_vector core_numbers(const csr_graph& graph)
+{
+  return peel_by_degree(graph).cores;
+}
+
+/**
+ * Compute the core number of every vertex with parallel level peeling.
+ *
+ * For each `k`, all remaining vertices of degree at most `k` form the first
+ * frontier. Frontier vertices get core number `k` and their neighbors'
+ * degrees are decremented in parallel with atomics; a neighbor joins the next
+ * frontier exactly when its decrement takes its degree from `k + 1` to `k`.
+ * Levels with no vertices are skipped by jumping to the minimum remaining
+ * degree. Total work is `O(E + V * L)` for `L` distinct core levels.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *    Self-loops are ignored.
+ *
+ * @param graph `const csr_graph&` undirected graph
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `vertex_index_vector` giving the core number of each vertex
+ */
+vertex_index_vector parallel_core_numbers(
+  const csr_graph& graph, std::size_t n_threads)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  std::size_t max_threads = resolve_n_threads(n_threads);
+  std::vector<std::atomic<vertex_index>> degrees(n_vertices);
+  std::vector<char> removed(n_vertices, false);
+  vertex_index_vector cores(n_vertices, 0);
+  parallel_for(
+    n_vertices,
+    [&](std::size_t begin, std::size_t end, std::size_t)
+    {
+      for (std::size_t v = begin; v < end; v++) {
+        degrees[v].store(
+          loopless_degree(graph, static_cast<vertex_index>(v)),
+          std::memory_order_relaxed
+        );
+      }
+    },
+    n_threads
+  );
+  std::vector<vertex_index_vector> buffers(max_threads);
+  vertex_index_vector frontier;
+  // gather per-thread buffers into the frontier and clear them
+  auto gather = [&]
+  {
+    frontier.clear();
+    for (vertex_index_vector& buffer : buffers) {
+      frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+      buffer.clear();
+    }
+  };
+  std::size_t n_remaining = n_vertices;
+  vertex_index k = 0;
+  while (n_remaining) {
+    std::vector<vertex_index> min_degrees(
+      max_threads, std::numeric_limits<vertex_index>::max()
+    );
+    parallel_for(
+      n_vertices,
+      [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+      {
+        for (std::size_t v = begin; v < end; v++) {
+          if (!removed[v]) {
+            min_degrees[thread_id] = std::min(
+              min_degrees[thread_id],
+              degrees[v].load(std::memory_order_relaxed)
+            );
+          }
+        }
+      },
+      n_threads
+    );
+    k = std::max(k, *std::min_element(min_degrees.begin(), min_degrees.end()));
+    parallel_for(
+      n_vertices,
+      [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+      {
+        for (std::size_t v = begin; v < end; v++) {
+          if (!removed[v] && degrees[v].load(std::memory_order_relaxed) <= k) {
+            buffers[thread_id].push_back(static_cast<vertex_index>(v));
+          }
+        }
+      },
+      n_threads
+    );
+    gather();
+    while (!frontier.empty()) {
+      for (vertex_index v : frontier) {
+        removed[v] = true;
+        cores[v] = k;
+      }
+      n_remaining -= frontier.size();
+      parallel_for(
+        frontier.size(),
+        [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+        {
+          for (std::size_t i = begin; i < end; i++) {
+            graph.for_each_neighbor(
+              frontier[i],
+              [&](vertex_index u, edge_index)
+              {
+                if (
+                  !removed[u] &&
+                  degrees[u].fetch_sub(1, std::memory_order_relaxed) == k + 1
+                ) {
+                  buffers[thread_id].push_back(u);
+                }
+              }
+            );
+          }
+        },
+        n_threads,
+        64
+      );
+      gather();
+    }
+    k++;
+  }
+  return cores;
+}
+
+}  // namespace pdcip
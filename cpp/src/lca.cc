@@ -0,0 +1,289 @@
+/**
+ * @file lca.cc
+ * @author Derek Huang
+ * @brief C++ source for lowest common ancestor queries on trees
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/lca.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Nodes of a tree numbered in pre-order, with their Euler tour.
+ */
+struct euler_layout {
+  tree_ptr_vector nodes;
+  vertex_index_vector parents;
+  vertex_index_vector depths;
+  vertex_index_vector tour;
+  vertex_index_vector first;
+  flat_hash_map<vertex_index> indices;
+};
+
+/**
+ * Number the nodes of a tree in pre-order and record its Euler tour.
+ *
+ * The walk is iterative, so deep trees cannot overflow the call stack.
+ * `nullptr` children, e.g. missing `binary_tree` children, are skipped.
+ *
+ * @param root `const tree_ptr&` root of the tree
+ */
+euler_layout euler_tour(const tree_ptr& root)
+{
+  assert(root);
+  euler_layout layout;
+  auto visit = [&](const tree_ptr& node, vertex_index parent)
+  {
+    auto index = static_cast<vertex_index>(layout.nodes.size());
+    auto slot = layout.indices.emplace(node_key(node.get()));
+    assert(slot.second && "tree nodes must not be shared");
+    slot.first = index;
+    layout.nodes.push_back(node);
+    layout.parents.push_back(parent);
+    layout.depths.push_back(
+      (index == parent) ? 0 : layout.depths[parent] + 1
+    );
+    layout.first.push_back(static_cast<vertex_index>(layout.tour.size()));
+    layout.tour.push_back(index);
+    return index;
+  };
+  // each entry is a node and the position of its next child to visit
+  std::vector<std::pair<vertex_index, std::size_t>> stack;
+  stack.emplace_back(visit(root, 0), 0);
+  while (!stack.empty()) {
+    vertex_index v = stack.back().first;
+    std::size_t& next = stack.back().second;
+    const tree_ptr_vector_ptr& children = layout.nodes[v]->children();
+    std::size_t n_children = children ? children->size() : 0;
+    while (next < n_children && !(*children)[next]) {
+      next++;
+    }
+    if (next < n_children) {
+      const tree_ptr& child = (*children)[next++];
+      stack.emplace_back(visit(child, v), 0);
+      continue;
+    }
+    stack.pop_back();
+    if (!stack.empty()) {
+      layout.tour.push_back(stack.back().first);
+    }
+  }
+  return layout;
+}
+
+/**
+ * Return the index of a tree node in a layout.
+ *
+ * @param indices `const flat_hash_map<vertex_index>&` node indices
+ * @param node `const tree_ptr&` tree node in the layout
+ */
+vertex_index find_index(
+  const flat_hash_map<vertex_index>& indices, const tree_ptr& node)
+{
+  const vertex_index* index = indices.find(node_key(node.get()));
+  assert(index && "node is not in the tree");
+  return *index;
+}
+
+}  // namespace
+
+/**
+ * `lca_index` constructor.
+ *
+ * @param root `const tree_ptr&` root of the tree
+ */
+lca_index::lca_index(const tree_ptr& root)
+{
+  euler_layout layout = euler_tour(root);
+  nodes_ = std::move(layout.nodes);
+  parents_ = std::move(layout.parents);
+  depths_ = std::move(layout.depths);
+  first_ = std::move(layout.first);
+  indices_ = std::move(layout.indices);
+  // level k holds the shallowest node of each tour window of length 2^k
+  table_.push_back(std::move(layout.tour));
+  for (std::size_t width = 2; width <= table_[0].size(); width *= 2) {
+    const vertex_index_vector& prev = table_.back();
+    vertex_index_vector level(table_[0].size() - width + 1);
+    for (std::size_t i = 0; i < level.size(); i++) {
+      level[i] = shallower(prev[i], prev[i + width / 2]);
+    }
+    table_.push_back(std::move(level));
+  }
+  // floor(log2(length)) of every query window length
+  log2_.assign(table_[0].size() + 1, 0);
+  for (std::size_t length = 2; length < log2_.size(); length++) {
+    log2_[length] = static_cast<std::uint8_t>(log2_[length / 2] + 1);
+  }
+}
+
+/**
+ * Return number of nodes in the indexed tree.
+ */
+std::size_t lca_index::n_nodes() const { return nodes_.size(); }
+
+/**
+ * Return the pre-order index of a tree node.
+ *
+ * @param node `const tree_ptr&` node of the indexed tree
+ */
+vertex_index lca_index::index(const tree_ptr& node) const
+{
+  return find_index(indices_, node);
+}
+
+/**
+ * Return the tree node with a given pre-order index.
+ *
+ * @param v `vertex_index` node index
+ */
+const tree_ptr& lca_index::node(vertex_index v) const { return nodes_[v]; }
+
+/**
+ * Return the index of a node's parent, the root being its own parent.
+ *
+ * @param v `vertex_index` node index
+ */
+vertex_index lca_index::parent(vertex_index v) const { return parents_[v]; }
+
+/**
+ * Return the depth of a node, the root having depth zero.
+ *
+ * @param v `vertex_index` node index
+ */
+vertex_index lca_index::depth(vertex_index v) const { return depths_[v]; }
+
+/**
+ * Return the index of the lowest common ancestor of two nodes.
+ *
+ * A node is its own ancestor, so the result is `u` if `u` is an ancestor of
+ * `v`.
+ *
+ * @param u `vertex_index` first node index
+ * @param v `vertex_index` second node index
+ */
+vertex_index lca_index::lca(vertex_index u, vertex_index v) const
+{
+  std::size_t begin = std::min(first_[u], first_[v]);
+  std::size_t end = std::max(first_[u], first_[v]) + 1;
+  std::size_t level = log2_[end - begin];
+  return shallower(
+    table_[level][begin], table_[level][end - (std::size_t(1) << level)]
+  );
+}
+
+/**
+ * Return the lowest common ancestor of two nodes.
+ *
+ * @param first `const tree_ptr&` first node of the indexed tree
+ * @param second `const tree_ptr&` second node of the indexed tree
+ */
+tree_ptr lca_index::lca(const tree_ptr& first, const tree_ptr& second) const
+{
+  return nodes_[lca(index(first), index(second))];
+}
+
+/**
+ * Return whichever of two nodes is shallower.
+ *
+ * @param u `vertex_index` first node index
+ * @param v `vertex_index` second node index
+ */
+vertex_index lca_index::shallower(vertex_index u, vertex_index v) const
+{
+  return (depths_[v] < depths_[u]) ? v : u;
+}
+
+/**
+ * Answer a batch of lowest common ancestor queries offline with Tarjan's
+ * algorithm.
+ *
+ * Walks the Euler tour once, merging each finished subtree into its parent
+ * in a union-find forest whose set representatives remember the node they
+ * were merged into. On entering a node, every query pairing it with an
+ * already entered node is answered by that node's set. Runs in
+ * `O(n + q * alpha(n))` for `q` queries without the `O(n log n)` table of
+ * `lca_index`, so it is cheaper when a tree is queried only once.
+ *
+ * @param root `const tree_ptr&` root of the tree
+ * @param firsts `const tree_ptr_vector&` first node of each query
+ * @param seconds `const tree_ptr_vector&` second node of each query
+ * @returns `tree_ptr_vector` with the lowest common ancestor of each query
+ */
+tree_ptr_vector tarjan_lca(
+  const tree_ptr& root,
+  const tree_ptr_vector& firsts,
+  const tree_ptr_vector& seconds)
+{
+  assert(firsts.size() == seconds.size());
+  euler_layout layout = euler_tour(root);
+  std::size_t n_nodes = layout.nodes.size();
+  std::size_t n_queries = firsts.size();
+  // queries grouped by node, each listed under both of its endpoints
+  vertex_index_vector ends(2 * n_queries);
+  edge_index_vector offsets(n_nodes + 1, 0);
+  for (std::size_t q = 0; q < n_queries; q++) {
+    ends[2 * q] = find_index(layout.indices, firsts[q]);
+    ends[2 * q + 1] = find_index(layout.indices, seconds[q]);
+    offsets[ends[2 * q] + 1]++;
+    offsets[ends[2 * q + 1] + 1]++;
+  }
+  for (std::size_t v = 0; v < n_nodes; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+  std::vector<std::size_t> slots(2 * n_queries);
+  {
+    edge_index_vector next(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < ends.size(); i++) {
+      slots[next[ends[i]]++] = i;
+    }
+  }
+  vertex_index_vector sets(n_nodes);
+  vertex_index_vector ancestors(n_nodes);
+  std::vector<bool> entered(n_nodes, false);
+  auto find = [&](vertex_index v)
+  {
+    while (sets[v] != v) {
+      sets[v] = sets[sets[v]];
+      v = sets[v];
+    }
+    return v;
+  };
+  tree_ptr_vector result(n_queries);
+  for (std::size_t i = 0; i < layout.tour.size(); i++) {
+    vertex_index v = layout.tour[i];
+    if (layout.first[v] != i) {
+      // returning from a finished child
+      vertex_index set = find(v);
+      sets[find(layout.tour[i - 1])] = set;
+      ancestors[set] = v;
+      continue;
+    }
+    entered[v] = true;
+    sets[v] = ancestors[v] = v;
+    for (std::size_t j = offsets[v]; j < offsets[v + 1]; j++) {
+      // the other endpoint sits next to this one in ends
+      vertex_index other = ends[slots[j] ^ 1];
+      if (entered[other]) {
+        result[slots[j] / 2] = layout.nodes[ancestors[find(other)]];
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace pdcip
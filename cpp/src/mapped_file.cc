@@ -0,0 +1,182 @@
+/**
+ * @file mapped_file.cc
+ * @author Derek Huang
+ * @brief C++ source for read-only memory-mapped files
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/mapped_file.h"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif  // WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace pdcip {
+
+/**
+ * Default constructor for a closed `mapped_file`.
+ */
+mapped_file::mapped_file()
+  : open_(false),
+    data_(nullptr),
+    size_(0)
+#ifdef _WIN32
+    , mapping_(nullptr)
+#endif  // _WIN32
+{}
+
+/**
+ * Map a whole file into memory for reading.
+ *
+ * Check `is_open` afterwards, which is `false` if the file could not be
+ * opened or mapped. An empty file is open with a `nullptr` data pointer.
+ *
+ * @param path `const std::string&` path of the file to map
+ */
+mapped_file::mapped_file(const std::string& path) : mapped_file()
+{
+#ifdef _WIN32
+  HANDLE file = CreateFileA(
+    path.c_str(),
+    GENERIC_READ,
+    FILE_SHARE_READ,
+    nullptr,
+    OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL,
+    nullptr
+  );
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size)) {
+    CloseHandle(file);
+    return;
+  }
+  size_ = static_cast<std::size_t>(file_size.QuadPart);
+  if (size_) {
+    mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_) {
+      data_ = static_cast<const char*>(
+        MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0)
+      );
+    }
+    if (!data_) {
+      if (mapping_) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+      }
+      CloseHandle(file);
+      size_ = 0;
+      return;
+    }
+  }
+  // the mapping keeps the file open on its own
+  CloseHandle(file);
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  struct stat info;
+  if (fstat(fd, &info) < 0) {
+    ::close(fd);
+    return;
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      size_ = 0;
+      return;
+    }
+    data_ = static_cast<const char*>(data);
+  }
+  // the mapping keeps the file open on its own
+  ::close(fd);
+#endif  // _WIN32
+  open_ = true;
+}
+
+/**
+ * Move constructor, leaving `other` closed.
+ *
+ * @param other `mapped_file&&` mapping to take over
+ */
+mapped_file::mapped_file(mapped_file&& other) noexcept : mapped_file()
+{
+  *this = std::move(other);
+}
+
+/**
+ * Destructor, releasing the mapping.
+ */
+mapped_file::~mapped_file() { close(); }
+
+/**
+ * Move assignment operator, leaving `other` closed.
+ *
+ * @param other `mapped_file&&` mapping to take over
+ */
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+  if (this != &other) {
+    close();
+    std::swap(open_, other.open_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+#ifdef _WIN32
+    std::swap(mapping_, other.mapping_);
+#endif  // _WIN32
+  }
+  return *this;
+}
+
+/**
+ * Return `true` if a file is currently mapped.
+ */
+bool mapped_file::is_open() const { return open_; }
+
+/**
+ * Return pointer to the first byte of the mapped file.
+ */
+const char* mapped_file::data() const { return data_; }
+
+/**
+ * Return the number of mapped bytes.
+ */
+std::size_t mapped_file::size() const { return size_; }
+
+/**
+ * Release the mapping, if any.
+ */
+void mapped_file::close()
+{
+  if (data_) {
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+    mapping_ = nullptr;
+#else
+    munmap(const_cast<char*>(data_), size_);
+#endif  // _WIN32
+  }
+  open_ = false;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace pdcip
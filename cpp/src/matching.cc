@@ -0,0 +1,232 @@
+/**
+ * @file matching.cc
+ * @author Derek Huang
+ * @brief C++ source for bipartite matching and assignment algorithms
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/matching.h"
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * Compute a maximum-cardinality bipartite matching with Hopcroft-Karp.
+ *
+ * Each phase layers the graph with a BFS from all free left vertices, then
+ * augments along a maximal set of vertex-disjoint shortest paths. The
+ * augmenting search is a DFS driven by an explicit stack of left vertices and
+ * per-vertex current-edge pointers, so no recursion is needed and no edge is
+ * scanned twice within a phase. Needs `O(sqrt(V))` phases of `O(E)` work.
+ *
+ * @param graph `const csr_graph&` graph whose edges from left vertices to
+ *    right vertices are the candidate pairs; all other edges are ignored
+ * @param left_side `const std::vector<bool>&` `true` for left vertices
+ */
+bipartite_matching hopcroft_karp(
+  const csr_graph& graph, const std::vector<bool>& left_side)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  assert(left_side.size() == n_vertices);
+  constexpr std::size_t infinity = std::numeric_limits<std::size_t>::max();
+  bipartite_matching matching{0, vertex_index_vector(n_vertices, unmatched)};
+  vertex_index_vector& mates = matching.mates;
+  vertex_index_vector left;
+  for (vertex_index v = 0; v < n_vertices; v++) {
+    if (left_side[v]) {
+      left.push_back(v);
+    }
+  }
+  std::vector<std::size_t> dists(n_vertices);
+  edge_index_vector current(n_vertices);
+  vertex_index_vector queue;
+  vertex_index_vector stack;
+  while (true) {
+    // layer left vertices by alternating path length from a free vertex
+    queue.clear();
+    for (vertex_index u : left) {
+      dists[u] = (mates[u] == unmatched) ? 0 : infinity;
+      if (mates[u] == unmatched) {
+        queue.push_back(u);
+      }
+    }
+    std::size_t free_dist = infinity;
+    for (std::size_t i = 0; i < queue.size(); i++) {
+      vertex_index u = queue[i];
+      if (dists[u] >= free_dist) {
+        break;
+      }
+      graph.for_each_neighbor(
+        u,
+        [&](vertex_index v, edge_index)
+        {
+          if (left_side[v]) {
+            return;
+          }
+          vertex_index w = mates[v];
+          if (w == unmatched) {
+            if (free_dist == infinity) {
+              free_dist = dists[u] + 1;
+            }
+          }
+          else if (dists[w] == infinity) {
+            dists[w] = dists[u] + 1;
+            queue.push_back(w);
+          }
+        }
+      );
+    }
+    if (free_dist == infinity) {
+      break;
+    }
+    for (vertex_index u : left) {
+      current[u] = graph.edges_begin(u);
+    }
+    for (vertex_index root : left) {
+      if (mates[root] != unmatched) {
+        continue;
+      }
+      stack.assign({root});
+      while (!stack.empty()) {
+        vertex_index u = stack.back();
+        if (current[u] == graph.edges_end(u)) {
+          // dead end, so drop u from this phase and advance its parent
+          dists[u] = infinity;
+          stack.pop_back();
+          if (!stack.empty()) {
+            current[stack.back()]++;
+          }
+          continue;
+        }
+        vertex_index v = graph.target(current[u]);
+        vertex_index w = (left_side[v]) ? unmatched : mates[v];
+        if (left_side[v]) {
+          current[u]++;
+        }
+        else if (w == unmatched) {
+          if (dists[u] + 1 != free_dist) {
+            current[u]++;
+            continue;
+          }
+          // flip the matching along the stack, whose current edges form the
+          // augmenting path
+          for (vertex_index x : stack) {
+            vertex_index y = graph.target(current[x]);
+            mates[x] = y;
+            mates[y] = x;
+          }
+          matching.size++;
+          break;
+        }
+        else if (dists[w] == dists[u] + 1) {
+          stack.push_back(w);
+        }
+        else {
+          current[u]++;
+        }
+      }
+    }
+  }
+  return matching;
+}
+
+/**
+ * Solve the rectangular assignment problem with the Hungarian algorithm.
+ *
+ * Uses the shortest augmenting path formulation with row and column
+ * potentials, adding one row at a time in `O(n_rows * n_cols)` work each, for
+ * `O(n^2 m)` overall with `n <= m`. All state lives in a handful of flat
+ * arrays, which keeps it fast on the dense matrices it is meant for. If there
+ * are more rows than columns the transposed problem is solved instead.
+ *
+ * @param costs `const double_vector&` row-major `n_rows` by `n_cols` matrix
+ * @param n_rows `std::size_t` number of rows, e.g. jobs
+ * @param n_cols `std::size_t` number of columns, e.g. workers
+ */
+assignment hungarian_assignment(
+  const double_vector& costs, std::size_t n_rows, std::size_t n_cols)
+{
+  assert(costs.size() == n_rows * n_cols);
+  if (n_rows > n_cols) {
+    double_vector transposed(costs.size());
+    for (std::size_t i = 0; i < n_rows; i++) {
+      for (std::size_t j = 0; j < n_cols; j++) {
+        transposed[j * n_rows + i] = costs[i * n_cols + j];
+      }
+    }
+    assignment flipped = hungarian_assignment(transposed, n_cols, n_rows);
+    assignment result{flipped.cost, vertex_index_vector(n_rows, unmatched)};
+    for (std::size_t j = 0; j < n_cols; j++) {
+      result.columns[flipped.columns[j]] = static_cast<vertex_index>(j);
+    }
+    return result;
+  }
+  constexpr double infinity = std::numeric_limits<double>::infinity();
+  // 1-based with row/column 0 as the virtual start of each augmenting path
+  double_vector row_pots(n_rows + 1, 0);
+  double_vector col_pots(n_cols + 1, 0);
+  std::vector<std::size_t> col_rows(n_cols + 1, 0);
+  std::vector<std::size_t> prev_cols(n_cols + 1, 0);
+  double_vector min_slack(n_cols + 1);
+  std::vector<bool> used(n_cols + 1);
+  for (std::size_t i = 1; i <= n_rows; i++) {
+    col_rows[0] = i;
+    std::size_t col = 0;
+    std::fill(min_slack.begin(), min_slack.end(), infinity);
+    std::fill(used.begin(), used.end(), false);
+    do {
+      used[col] = true;
+      std::size_t row = col_rows[col];
+      const double* row_costs = costs.data() + (row - 1) * n_cols;
+      double delta = infinity;
+      std::size_t next_col = 0;
+      for (std::size_t j = 1; j <= n_cols; j++) {
+        if (used[j]) {
+          continue;
+        }
+        double slack = row_costs[j - 1] - row_pots[row] - col_pots[j];
+        if (slack < min_slack[j]) {
+          min_slack[j] = slack;
+          prev_cols[j] = col;
+        }
+        if (min_slack[j] < delta) {
+          delta = min_slack[j];
+          next_col = j;
+        }
+      }
+      for (std::size_t j = 0; j <= n_cols; j++) {
+        if (used[j]) {
+          row_pots[col_rows[j]] += delta;
+          col_pots[j] -= delta;
+        }
+        else {
+          min_slack[j] -= delta;
+        }
+      }
+      col = next_col;
+    } while (col_rows[col]);
+    // walk the augmenting path back to the virtual column
+    do {
+      std::size_t prev_col = prev_cols[col];
+      col_rows[col] = col_rows[prev_col];
+      col = prev_col;
+    } while (col);
+  }
+  assignment result{0, vertex_index_vector(n_rows, unmatched)};
+  for (std::size_t j = 1; j <= n_cols; j++) {
+    if (col_rows[j]) {
+      result.columns[col_rows[j] - 1] = static_cast<vertex_index>(j - 1);
+      result.cost += costs[(col_rows[j] - 1) * n_cols + j - 1];
+    }
+  }
+  return result;
+}
+
+}  // namespace pdcip
@@ -0,0 +1,128 @@
+/**
+ * @file merkle.cc
+ * @author Derek Huang
+ * @brief C++ source for Merkle hashing of trees
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/merkle.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+/**
+ * `merkle_hashes` constructor.
+ *
+ * Lists the nodes breadth-first, then hashes them in reverse, so every
+ * node's children are hashed before it without recursion.
+ *
+ * @param root `const tree_ptr&` root of the tree
+ */
+merkle_hashes::merkle_hashes(const tree_ptr& root) : root_(root)
+{
+  assert(root);
+  std::vector<const tree*> order{root.get()};
+  for (std::size_t i = 0; i < order.size(); i++) {
+    if (!order[i]->children()) {
+      continue;
+    }
+    for (const tree_ptr& child : *order[i]->children()) {
+      if (child) {
+        order.push_back(child.get());
+      }
+    }
+  }
+  hashes_.reserve(order.size());
+  for (std::size_t i = order.size(); i-- > 0; ) {
+    const tree* node = order[i];
+    std::uint64_t result = merkle_value_hash(node->value());
+    if (node->children()) {
+      for (const tree_ptr& child : *node->children()) {
+        result = merkle_combine(
+          result, child ? hash(child.get()) : merkle_null_hash
+        );
+      }
+    }
+    auto slot = hashes_.emplace(node_key(node));
+    assert(slot.second && "tree nodes must not be shared");
+    slot.first = result;
+  }
+}
+
+/**
+ * Return the root of the hashed tree.
+ */
+const tree_ptr& merkle_hashes::root() const { return root_; }
+
+/**
+ * Return number of hashed nodes.
+ */
+std::size_t merkle_hashes::size() const { return hashes_.size(); }
+
+/**
+ * Return the hash of the whole tree.
+ */
+std::uint64_t merkle_hashes::root_hash() const { return hash(root_.get()); }
+
+/**
+ * Return the hash of the subtree rooted at a node.
+ *
+ * @param node `const tree*` node of the hashed tree
+ */
+std::uint64_t merkle_hashes::hash(const tree* node) const
+{
+  const std::uint64_t* result = hashes_.find(node_key(node));
+  assert(result && "node is not in the tree");
+  return *result;
+}
+
+/**
+ * Return the differing nodes of this tree and another.
+ *
+ * @param other `const merkle_hashes&` hashes of the other tree
+ * @returns `changed_node_vector` with pairs of nodes from this tree and
+ *    `other`, see `diff_subtrees`
+ */
+changed_node_vector merkle_hashes::diff(const merkle_hashes& other) const
+{
+  changed_node_vector result;
+  diff_subtrees(
+    root_.get(),
+    other.root_.get(),
+    [this](const tree* node) { return hash(node); },
+    [&other](const tree* node) { return other.hash(node); },
+    result
+  );
+  return result;
+}
+
+/**
+ * Test two trees for equality by their root hashes.
+ *
+ * @param first `const merkle_hashes&` hashes of the first tree
+ * @param second `const merkle_hashes&` hashes of the second tree
+ */
+bool operator==(const merkle_hashes& first, const merkle_hashes& second)
+{
+  return first.root_hash() == second.root_hash();
+}
+
+/**
+ * Test two trees for inequality by their root hashes.
+ *
+ * @param first `const merkle_hashes&` hashes of the first tree
+ * @param second `const merkle_hashes&` hashes of the second tree
+ */
+bool operator!=(const merkle_hashes& first, const merkle_hashes& second)
+{
+  return !(first == second);
+}
+
+}  // namespace pdcip
@@ -0,0 +1,346 @@
+/**
+ * @file mst.cc
+ * @author Derek Huang
+ * @brief C++ source for minimum spanning tree/forest algorithms
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/mst.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/indexed_heap.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Sentinel edge index meaning "no edge".
+ */
+constexpr edge_index no_edge = std::numeric_limits<edge_index>::max();
+
+/**
+ * Union-find over vertex indices with union by rank and path halving.
+ */
+class disjoint_set {
+public:
+  /**
+   * `disjoint_set` constructor making every vertex its own set.
+   *
+   * @param n `std::size_t` number of vertices
+   */
+  disjoint_set(std::size_t n) : parent_(n), rank_(n, 0)
+  {
+    for (std::size_t i = 0; i < n; i++) {
+      parent_[i] = static_cast<vertex_index>(i);
+    }
+  }
+
+  /**
+   * Return the root of the set containing `vert`, halving the path.
+   *
+   * @param vert `vertex_index` vertex to find set root of
+   */
+  vertex_index find(vertex_index vert)
+  {
+    while (parent_[vert] != vert) {
+      parent_[vert] = parent_[parent_[vert]];
+      vert = parent_[vert];
+    }
+    return vert;
+  }
+
+  /**
+   * Return the root of the set containing `vert` without modifying anything.
+   *
+   * Safe to call concurrently as long as no thread is writing.
+   *
+   * @param vert `vertex_index` vertex to find set root of
+   */
+  vertex_index find_root(vertex_index vert) const
+  {
+    while (parent_[vert] != vert) {
+      vert = parent_[vert];
+    }
+    return vert;
+  }
+
+  /**
+   * Merge the sets containing `first` and `second`.
+   *
+   * @param first `vertex_index` first vertex
+   * @param second `vertex_index` second vertex
+   * @returns `true` if the vertices were in different sets
+   */
+  bool unite(vertex_index first, vertex_index second)
+  {
+    first = find(first);
+    second = find(second);
+    if (first == second) {
+      return false;
+    }
+    if (rank_[first] < rank_[second]) {
+      std::swap(first, second);
+    }
+    parent_[second] = first;
+    if (rank_[first] == rank_[second]) {
+      rank_[first]++;
+    }
+    return true;
+  }
+
+private:
+  vertex_index_vector parent_;
+  std::vector<unsigned char> rank_;
+};
+
+/**
+ * Return the index of the `(min(u, v), max(u, v))` direction of an edge.
+ *
+ * @param graph `const csr_graph&` symmetric graph
+ * @param e `edge_index` edge in either direction
+ * @param source `vertex_index` source vertex of `e`
+ */
+edge_index canonical_edge(
+  const csr_graph& graph, edge_index e, vertex_index source)
+{
+  vertex_index target = graph.target(e);
+  if (source < target) {
+    return e;
+  }
+  const vertex_index* found = std::lower_bound(
+    graph.neighbors_begin(target), graph.neighbors_end(target), source
+  );
+  assert(found != graph.neighbors_end(target) && *found == source);
+  return graph.edges_begin(target) + (found - graph.neighbors_begin(target));
+}
+
+/**
+ * Build a `spanning_forest` from chosen edges, summing up their weights.
+ *
+ * @param graph `const csr_graph&` graph the edges belong to
+ * @param edges `edge_index_vector&&` chosen edges
+ */
+spanning_forest make_forest(const csr_graph& graph, edge_index_vector&& edges)
+{
+  double total_weight = 0;
+  for (edge_index e : edges) {
+    total_weight += graph.weight(e);
+  }
+  return {std::move(edges), total_weight};
+}
+
+}  // namespace
+
+/**
+ * Compute a minimum spanning forest with Kruskal's algorithm.
+ *
+ * The `u < v` edges are sorted by weight with `parallel_sort`, which
+ * dominates the `O(E log E)` running time, then scanned once with a
+ * union-find to drop edges that would close a cycle.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *
+ * @param graph `const csr_graph&` undirected weighted graph
+ * @param n_threads `std::size_t` number of sorting threads, `0` for default
+ * @returns `spanning_forest` with the forest edges in nondecreasing weight
+ */
+spanning_forest kruskal_mst(const csr_graph& graph, std::size_t n_threads)
+{
+  vertex_index_vector sources = graph.edge_sources();
+  edge_index_vector candidates;
+  candidates.reserve(graph.n_edges() / 2);
+  for (edge_index e = 0; e < graph.n_edges(); e++) {
+    if (sources[e] < graph.target(e)) {
+      candidates.push_back(e);
+    }
+  }
+  // ties are broken by edge index so the result is deterministic
+  parallel_sort(
+    candidates.begin(),
+    candidates.end(),
+    [&graph](edge_index a, edge_index b)
+    {
+      return
+        std::make_pair(graph.weight(a), a) < std::make_pair(graph.weight(b), b);
+    },
+    n_threads
+  );
+  disjoint_set components(graph.n_vertices());
+  edge_index_vector edges;
+  for (edge_index e : candidates) {
+    if (edges.size() + 1 >= graph.n_vertices()) {
+      break;
+    }
+    if (components.unite(sources[e], graph.target(e))) {
+      edges.push_back(e);
+    }
+  }
+  return make_forest(graph, std::move(edges));
+}
+
+/**
+ * Compute a minimum spanning forest with Prim's algorithm.
+ *
+ * Each tree is grown from its smallest unvisited vertex using an
+ * `indexed_heap` keyed by the lightest known edge into each fringe vertex, so
+ * the heap never holds more than `V` entries. Runs in `O(E log V)` time.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *
+ * @param graph `const csr_graph&` undirected weighted graph
+ * @returns `spanning_forest` with the forest edges in the order they were added
+ */
+spanning_forest prim_mst(const csr_graph& graph)
+{
+  using heap_key = std::pair<double, edge_index>;
+  indexed_heap<heap_key> fringe(graph.n_vertices());
+  std::vector<bool> visited(graph.n_vertices(), false);
+  vertex_index_vector best_source(graph.n_vertices());
+  edge_index_vector edges;
+  for (std::size_t root = 0; root < graph.n_vertices(); root++) {
+    if (visited[root]) {
+      continue;
+    }
+    fringe.push_or_decrease(
+      static_cast<vertex_index>(root), heap_key(0, no_edge)
+    );
+    while (!fringe.empty()) {
+      edge_index via = fringe.key(fringe.top()).second;
+      vertex_index vert = fringe.pop();
+      visited[vert] = true;
+      if (via != no_edge) {
+        edges.push_back(canonical_edge(graph, via, best_source[vert]));
+      }
+      graph.for_each_neighbor(
+        vert,
+        [&](vertex_index next, edge_index e)
+        {
+          if (
+            !visited[next] &&
+            fringe.push_or_decrease(next, heap_key(graph.weight(e), e))
+          ) {
+            best_source[next] = vert;
+          }
+        }
+      );
+    }
+  }
+  return make_forest(graph, std::move(edges));
+}
+
+/**
+ * Compute a minimum spanning forest with a multithreaded Borůvka algorithm.
+ *
+ * Each round, threads scan disjoint vertex ranges and publish the lightest
+ * edge leaving each component with an atomic compare-and-swap, then all
+ * chosen edges are contracted with a union-find and component labels are
+ * refreshed in parallel. The number of components at least halves per round,
+ * so there are `O(log V)` rounds of `O(E / n_threads)` work each.
+ *
+ * @note `graph` must be symmetric, e.g. from `csr_graph::symmetrize`.
+ *
+ * @param graph `const csr_graph&` undirected weighted graph
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `spanning_forest` with the forest edges in the order they were added
+ */
+spanning_forest boruvka_mst(const csr_graph& graph, std::size_t n_threads)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  vertex_index_vector sources = graph.edge_sources();
+  // edges are totally ordered by (weight, smaller end, larger end), which
+  // makes the lightest edge out of each component unique and rules out cycles
+  auto edge_key = [&](edge_index e)
+  {
+    vertex_index u = sources[e];
+    vertex_index v = graph.target(e);
+    return std::make_tuple(graph.weight(e), std::min(u, v), std::max(u, v));
+  };
+  disjoint_set components(n_vertices);
+  vertex_index_vector labels(n_vertices);
+  vertex_index_vector roots(n_vertices);
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    labels[v] = roots[v] = static_cast<vertex_index>(v);
+  }
+  std::vector<std::atomic<edge_index>> lightest(n_vertices);
+  edge_index_vector edges;
+  while (roots.size() > 1) {
+    for (vertex_index root : roots) {
+      lightest[root].store(no_edge, std::memory_order_relaxed);
+    }
+    parallel_for(
+      n_vertices,
+      [&](std::size_t begin, std::size_t end, std::size_t)
+      {
+        for (std::size_t u = begin; u < end; u++) {
+          edge_index best = no_edge;
+          graph.for_each_neighbor(
+            static_cast<vertex_index>(u),
+            [&](vertex_index v, edge_index e)
+            {
+              if (
+                labels[u] != labels[v] &&
+                (best == no_edge || edge_key(e) < edge_key(best))
+              ) {
+                best = e;
+              }
+            }
+          );
+          if (best == no_edge) {
+            continue;
+          }
+          std::atomic<edge_index>& slot = lightest[labels[u]];
+          edge_index current = slot.load(std::memory_order_relaxed);
+          while (
+            (current == no_edge || edge_key(best) < edge_key(current)) &&
+            !slot.compare_exchange_weak(current, best)
+          );
+        }
+      },
+      n_threads
+    );
+    std::size_t n_edges = edges.size();
+    for (vertex_index root : roots) {
+      edge_index e = lightest[root].load(std::memory_order_relaxed);
+      if (e != no_edge && components.unite(sources[e], graph.target(e))) {
+        edges.push_back(canonical_edge(graph, e, sources[e]));
+      }
+    }
+    // no edge leaves any component, so the forest is complete
+    if (edges.size() == n_edges) {
+      break;
+    }
+    parallel_for(
+      n_vertices,
+      [&](std::size_t begin, std::size_t end, std::size_t)
+      {
+        for (std::size_t v = begin; v < end; v++) {
+          labels[v] = components.find_root(labels[v]);
+        }
+      },
+      n_threads
+    );
+    roots.erase(
+      std::remove_if(
+        roots.begin(),
+        roots.end(),
+        [&](vertex_index root) { return components.find_root(root) != root; }
+      ),
+      roots.end()
+    );
+  }
+  return make_forest(graph, std::move(edges));
+}
+
+}  // namespace pdcip
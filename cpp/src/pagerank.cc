@@ -0,0 +1,227 @@
+/**
+ * @file pagerank.cc
+ * @author Derek Huang
+ * @brief C++ source for PageRank and personalized PageRank
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/pagerank.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+
+#include "pdcip/cpp/compressed_graph.h"
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Return the inverse out-degree of every vertex, `0` for dangling vertices.
+ *
+ * @tparam graph_t `csr_graph` or `compressed_graph`
+ * @param graph `const graph_t&` directed graph
+ */
+template <typename graph_t>
+double_vector inverse_degrees(const graph_t& graph)
+{
+  double_vector inverses(graph.n_vertices());
+  for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+    std::size_t degree = graph.degree(v);
+    inverses[v] = (degree) ? 1. / degree : 0;
+  }
+  return inverses;
+}
+
+}  // namespace
+
+/**
+ * `pagerank` constructor.
+ *
+ * @param graph `const csr_graph&` directed graph to rank the vertices of
+ * @param damping `double` probability of following an edge instead of
+ *    teleporting, in `[0, 1)`
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+pagerank::pagerank(
+  const csr_graph& graph, double damping, std::size_t n_threads)
+  : pagerank(graph.transpose(), inverse_degrees(graph), damping, n_threads)
+{}
+
+/**
+ * `pagerank` constructor for a compressed graph.
+ *
+ * The rows are decoded once to build the transpose, so the graph is never
+ * decompressed as a whole, but the transpose is kept uncompressed.
+ *
+ * @param graph `const compressed_graph&` directed graph to rank the vertices
+ *    of
+ * @param damping `double` probability of following an edge instead of
+ *    teleporting, in `[0, 1)`
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+pagerank::pagerank(
+  const compressed_graph& graph, double damping, std::size_t n_threads)
+  : pagerank(graph.transpose(), inverse_degrees(graph), damping, n_threads)
+{}
+
+/**
+ * `pagerank` constructor taking the transpose and inverse out-degrees.
+ *
+ * @param in_edges `csr_graph&&` transpose of the graph to rank
+ * @param inv_out_degrees `double_vector&&` inverse out-degrees of the graph
+ * @param damping `double` probability of following an edge instead of
+ *    teleporting, in `[0, 1)`
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+pagerank::pagerank(
+  csr_graph&& in_edges,
+  double_vector&& inv_out_degrees,
+  double damping,
+  std::size_t n_threads)
+  : in_edges_(std::move(in_edges)),
+    inv_out_degrees_(std::move(inv_out_degrees)),
+    contribs_(in_edges_.n_vertices()),
+    next_ranks_(in_edges_.n_vertices()),
+    teleport_(in_edges_.n_vertices()),
+    damping_(damping),
+    n_threads_(n_threads)
+{
+  assert(damping >= 0 && damping < 1);
+}
+
+/**
+ * Return number of vertices being ranked.
+ */
+std::size_t pagerank::n_vertices() const { return in_edges_.n_vertices(); }
+
+/**
+ * Return the damping factor.
+ */
+double pagerank::damping() const { return damping_; }
+
+/**
+ * Compute standard PageRank with uniform teleportation.
+ *
+ * @param ranks `double_vector&` rank output. If it already has
+ *    `n_vertices()` elements it is used as the starting guess, which speeds up
+ *    convergence when re-ranking a slightly changed graph.
+ * @param tolerance `double` stop once the L1 change between iterations drops
+ *    below this value
+ * @param max_iterations `std::size_t` maximum number of iterations
+ * @returns `std::size_t` number of iterations run
+ */
+std::size_t pagerank::solve(
+  double_vector& ranks, double tolerance, std::size_t max_iterations)
+{
+  std::fill(teleport_.begin(), teleport_.end(), 1. / n_vertices());
+  return iterate(ranks, tolerance, max_iterations);
+}
+
+/**
+ * Compute personalized PageRank with a custom teleport distribution.
+ *
+ * @param ranks `double_vector&` rank output, see the other overload
+ * @param teleport `const double_vector&` nonnegative teleport weights with a
+ *    positive sum, normalized internally to a probability distribution
+ * @param tolerance `double` stop once the L1 change between iterations drops
+ *    below this value
+ * @param max_iterations `std::size_t` maximum number of iterations
+ * @returns `std::size_t` number of iterations run
+ */
+std::size_t pagerank::solve(
+  double_vector& ranks,
+  const double_vector& teleport,
+  double tolerance,
+  std::size_t max_iterations)
+{
+  assert(teleport.size() == n_vertices());
+  double total = std::accumulate(teleport.begin(), teleport.end(), 0.);
+  assert(total > 0);
+  for (std::size_t v = 0; v < n_vertices(); v++) {
+    assert(teleport[v] >= 0);
+    teleport_[v] = teleport[v] / total;
+  }
+  return iterate(ranks, tolerance, max_iterations);
+}
+
+/**
+ * Run the power iteration with the current teleport distribution.
+ *
+ * Each iteration is two parallel passes. The first scales every rank by the
+ * inverse out-degree and sums up the dangling rank, the second pulls the
+ * scaled ranks along in-edges, which is a sparse matrix-vector product with
+ * the transpose that needs no atomics since each thread owns its rows.
+ *
+ * @param ranks `double_vector&` rank output and optional starting guess
+ * @param tolerance `double` L1 convergence tolerance
+ * @param max_iterations `std::size_t` maximum number of iterations
+ * @returns `std::size_t` number of iterations run
+ */
+std::size_t pagerank::iterate(
+  double_vector& ranks, double tolerance, std::size_t max_iterations)
+{
+  std::size_t n = n_vertices();
+  if (ranks.size() != n) {
+    ranks = teleport_;
+  }
+  double_vector partials(resolve_n_threads(n_threads_));
+  for (std::size_t iteration = 1; iteration <= max_iterations; iteration++) {
+    std::fill(partials.begin(), partials.end(), 0);
+    parallel_for(
+      n,
+      [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+      {
+        double dangling = 0;
+        for (std::size_t u = begin; u < end; u++) {
+          if (!inv_out_degrees_[u]) {
+            dangling += ranks[u];
+          }
+          contribs_[u] = ranks[u] * inv_out_degrees_[u];
+        }
+        partials[thread_id] += dangling;
+      },
+      n_threads_
+    );
+    double dangling = std::accumulate(partials.begin(), partials.end(), 0.);
+    std::fill(partials.begin(), partials.end(), 0);
+    parallel_for(
+      n,
+      [&](std::size_t begin, std::size_t end, std::size_t thread_id)
+      {
+        double residual = 0;
+        for (std::size_t v = begin; v < end; v++) {
+          double pulled = 0;
+          for (
+            const vertex_index* u = in_edges_.neighbors_begin(v);
+            u != in_edges_.neighbors_end(v);
+            u++
+          ) {
+            pulled += contribs_[*u];
+          }
+          double rank =
+            (1 - damping_) * teleport_[v] +
+            damping_ * (pulled + dangling * teleport_[v]);
+          residual += std::abs(rank - ranks[v]);
+          next_ranks_[v] = rank;
+        }
+        partials[thread_id] += residual;
+      },
+      n_threads_
+    );
+    std::swap(ranks, next_ranks_);
+    if (std::accumulate(partials.begin(), partials.end(), 0.) < tolerance) {
+      return iteration;
+    }
+  }
+  return max_iterations;
+}
+
+}  // namespace pdcip
@@ -0,0 +1,26 @@
+/**
+ * @file parallel.cc
+ * @author Derek Huang
+ * @brief C++ source for simple thread-based parallel loop helpers
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/parallel.h"
+
+#include <cstddef>
+#include <thread>
+
+namespace pdcip {
+
+/**
+ * Return the default number of threads used by the parallel helpers.
+ *
+ * Falls back to `1` if the hardware concurrency cannot be determined.
+ */
+std::size_t default_n_threads()
+{
+  std::size_t n_threads = std::thread::hardware_concurrency();
+  return (n_threads) ? n_threads : 1;
+}
+
+}  // namespace pdcip
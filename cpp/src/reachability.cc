@@ -0,0 +1,317 @@
+/**
+ * @file reachability.cc
+ * @author Derek Huang
+ * @brief C++ source for a DAG reachability index
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/reachability.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/dag.h"
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/parallel.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * OR the landmark bitsets of each vertex's neighbors into its own, level by
+ * level, so that bits flow from the last level visited to the first.
+ *
+ * Neighbors always lie on levels already visited, so the vertices of one
+ * level are independent and are processed in parallel.
+ *
+ * @param graph `const csr_graph&` graph whose out-edges give the neighbors
+ * @param levels `const topological_levels&` levels of the DAG
+ * @param reverse `bool` `true` to visit levels last to first
+ * @param n_words `std::size_t` words per bitset
+ * @param bits `std::vector<std::uint64_t>&` bitsets, `n_words` per vertex
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+void propagate_bits(
+  const csr_graph& graph,
+  const topological_levels& levels,
+  bool reverse,
+  std::size_t n_words,
+  std::vector<std::uint64_t>& bits,
+  std::size_t n_threads)
+{
+  std::size_t n_levels = levels.n_levels();
+  for (std::size_t i = 0; i < n_levels; i++) {
+    std::size_t level = reverse ? n_levels - 1 - i : i;
+    std::size_t begin = levels.level_offsets[level];
+    parallel_for(
+      levels.level_offsets[level + 1] - begin,
+      [&](std::size_t first, std::size_t last, std::size_t)
+      {
+        for (std::size_t j = begin + first; j < begin + last; j++) {
+          vertex_index v = levels.order[j];
+          std::uint64_t* own = bits.data() + v * n_words;
+          graph.for_each_neighbor(
+            v,
+            [&](vertex_index u, edge_index)
+            {
+              const std::uint64_t* other = bits.data() + u * n_words;
+              for (std::size_t k = 0; k < n_words; k++) {
+                own[k] |= other[k];
+              }
+            }
+          );
+        }
+      },
+      n_threads
+    );
+  }
+}
+
+}  // namespace
+
+/**
+ * `reachability_index` constructor.
+ *
+ * Builds every label in `O((V + E) * n_words)` time and stores
+ * `O(V * n_words)` words.
+ *
+ * @note `graph` must be acyclic.
+ *
+ * @param graph `const csr_graph&` directed acyclic graph
+ * @param n_words `std::size_t` number of 64-landmark words per vertex
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ */
+reachability_index::reachability_index(
+  const csr_graph& graph, std::size_t n_words, std::size_t n_threads)
+  : graph_(graph), n_words_(n_words)
+{
+  std::size_t n_vertices = graph.n_vertices();
+  topological_levels levels = topological_sort(graph);
+  assert(levels.acyclic() && "graph must be acyclic");
+  levels_.resize(n_vertices);
+  for (std::size_t level = 0; level < levels.n_levels(); level++) {
+    for (
+      std::size_t i = levels.level_offsets[level];
+      i < levels.level_offsets[level + 1];
+      i++
+    ) {
+      levels_[levels.order[i]] = static_cast<vertex_index>(level);
+    }
+  }
+  // iterative DFS from the sources in topological order. post-order of a DAG
+  // is a reverse topological order, so low() is final when a vertex finishes
+  pre_.resize(n_vertices);
+  pre_end_.resize(n_vertices);
+  post_.resize(n_vertices);
+  low_.resize(n_vertices);
+  std::vector<bool> visited(n_vertices, false);
+  std::vector<std::pair<vertex_index, edge_index>> stack;
+  vertex_index n_pre = 0;
+  vertex_index n_post = 0;
+  for (vertex_index root : levels.order) {
+    if (visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    pre_[root] = n_pre++;
+    stack.emplace_back(root, graph.edges_begin(root));
+    while (!stack.empty()) {
+      auto& [v, e] = stack.back();
+      if (e < graph.edges_end(v)) {
+        vertex_index u = graph.target(e++);
+        if (!visited[u]) {
+          visited[u] = true;
+          pre_[u] = n_pre++;
+          stack.emplace_back(u, graph.edges_begin(u));
+        }
+        continue;
+      }
+      pre_end_[v] = n_pre;
+      post_[v] = n_post++;
+      low_[v] = post_[v];
+      for (edge_index f = graph.edges_begin(v); f < graph.edges_end(v); f++) {
+        low_[v] = std::min(low_[v], low_[graph.target(f)]);
+      }
+      stack.pop_back();
+    }
+  }
+  // landmarks are the vertices with the most paths through them locally
+  n_landmarks_ = std::min(64 * n_words_, n_vertices);
+  vertex_index_vector landmarks(n_vertices);
+  std::iota(landmarks.begin(), landmarks.end(), 0);
+  edge_index_vector in_degrees = graph.in_degrees();
+  auto centrality = [&](vertex_index v)
+  {
+    return (in_degrees[v] + 1) * (graph.degree(v) + 1);
+  };
+  std::partial_sort(
+    landmarks.begin(),
+    landmarks.begin() + n_landmarks_,
+    landmarks.end(),
+    [&](vertex_index a, vertex_index b)
+    {
+      return centrality(a) > centrality(b);
+    }
+  );
+  out_bits_.assign(n_vertices * n_words_, 0);
+  in_bits_.assign(n_vertices * n_words_, 0);
+  for (std::size_t i = 0; i < n_landmarks_; i++) {
+    std::uint64_t bit = std::uint64_t(1) << (i % 64);
+    out_bits_[landmarks[i] * n_words_ + i / 64] |= bit;
+    in_bits_[landmarks[i] * n_words_ + i / 64] |= bit;
+  }
+  propagate_bits(graph, levels, true, n_words_, out_bits_, n_threads);
+  propagate_bits(
+    graph.transpose(), levels, false, n_words_, in_bits_, n_threads
+  );
+}
+
+/**
+ * Return number of vertices in the indexed graph.
+ */
+std::size_t reachability_index::n_vertices() const { return levels_.size(); }
+
+/**
+ * Return number of landmark vertices.
+ */
+std::size_t reachability_index::n_landmarks() const { return n_landmarks_; }
+
+/**
+ * Return `true` if there is a directed path from one vertex to another.
+ *
+ * Every vertex reaches itself.
+ *
+ * @param source `vertex_index` start of the path
+ * @param target `vertex_index` end of the path
+ */
+bool reachability_index::reachable(
+  vertex_index source, vertex_index target) const
+{
+  std::optional<bool> known = label_check(source, target);
+  if (known) {
+    return *known;
+  }
+  // labels don't settle it, so search while pruning with the labels
+  flat_hash_map<std::uint8_t> visited;
+  vertex_index_vector stack{source};
+  visited.emplace(source);
+  while (!stack.empty()) {
+    vertex_index v = stack.back();
+    stack.pop_back();
+    for (
+      const vertex_index* u = graph_.neighbors_begin(v);
+      u < graph_.neighbors_end(v);
+      u++
+    ) {
+      if (!visited.emplace(*u).second) {
+        continue;
+      }
+      known = label_check(*u, target);
+      if (!known) {
+        stack.push_back(*u);
+      }
+      else if (*known) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Answer many reachability queries in parallel.
+ *
+ * @param sources `const vertex_index_vector&` start of each path
+ * @param targets `const vertex_index_vector&` end of each path
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::vector<std::uint8_t>` with `1` where the target is reachable
+ *    from the source and `0` elsewhere
+ */
+std::vector<std::uint8_t> reachability_index::reachable(
+  const vertex_index_vector& sources,
+  const vertex_index_vector& targets,
+  std::size_t n_threads) const
+{
+  assert(sources.size() == targets.size());
+  std::vector<std::uint8_t> result(sources.size());
+  parallel_for(
+    sources.size(),
+    [&](std::size_t begin, std::size_t end, std::size_t)
+    {
+      for (std::size_t i = begin; i < end; i++) {
+        result[i] = reachable(sources[i], targets[i]);
+      }
+    },
+    n_threads
+  );
+  return result;
+}
+
+/**
+ * Try to settle a query from the labels alone.
+ *
+ * @param source `vertex_index` start of the path
+ * @param target `vertex_index` end of the path
+ * @returns `std::optional<bool>` with the answer, empty if unknown
+ */
+std::optional<bool> reachability_index::label_check(
+  vertex_index source, vertex_index target) const
+{
+  if (source == target) {
+    return true;
+  }
+  if (
+    levels_[source] >= levels_[target] ||
+    post_[target] > post_[source] ||
+    post_[target] < low_[source]
+  ) {
+    return false;
+  }
+  if (pre_[source] <= pre_[target] && pre_[target] < pre_end_[source]) {
+    return true;
+  }
+  const std::uint64_t* source_out = out_bits(source);
+  const std::uint64_t* source_in = in_bits(source);
+  const std::uint64_t* target_out = out_bits(target);
+  const std::uint64_t* target_in = in_bits(target);
+  for (std::size_t k = 0; k < n_words_; k++) {
+    if (source_out[k] & target_in[k]) {
+      return true;
+    }
+    if ((target_out[k] & ~source_out[k]) || (source_in[k] & ~target_in[k])) {
+      return false;
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * Return pointer to the bitset of landmarks a vertex reaches.
+ *
+ * @param v `vertex_index` vertex
+ */
+const std::uint64_t* reachability_index::out_bits(vertex_index v) const
+{
+  return out_bits_.data() + v * n_words_;
+}
+
+/**
+ * Return pointer to the bitset of landmarks that reach a vertex.
+ *
+ * @param v `vertex_index` vertex
+ */
+const std::uint64_t* reachability_index::in_bits(vertex_index v) const
+{
+  return in_bits_.data() + v * n_words_;
+}
+
+}  // namespace pdcip
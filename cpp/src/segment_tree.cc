@@ -0,0 +1,333 @@
+/**
+ * @file segment_tree.cc
+ * @author Derek Huang
+ * @brief C++ source for a lazy propagation segment tree
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/segment_tree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+}  // namespace
+
+/**
+ * `segment_tree` constructor.
+ *
+ * Builds in `O(n)` by filling the leaves and combining upwards.
+ *
+ * @param values `const double_vector&` initial values
+ */
+segment_tree::segment_tree(const double_vector& values)
+  : n_values_(values.size()), height_(0)
+{
+  while ((std::size_t(1) << height_) < n_values_) {
+    height_++;
+  }
+  std::size_t n_leaves = std::size_t(1) << height_;
+  // padding leaves are the aggregate of no values
+  nodes_.assign(2 * n_leaves, {0, inf, -inf, 0, 0, false});
+  for (std::size_t i = 0; i < n_values_; i++) {
+    nodes_[n_leaves + i].sum = values[i];
+    nodes_[n_leaves + i].min = values[i];
+    nodes_[n_leaves + i].max = values[i];
+  }
+  for (std::size_t level = n_leaves / 2, len = 2; level; level /= 2, len *= 2) {
+    for (std::size_t i = level; i < 2 * level; i++) {
+      rebuild(i, len);
+    }
+  }
+}
+
+/**
+ * Return number of values.
+ */
+std::size_t segment_tree::size() const { return n_values_; }
+
+/**
+ * Add to every value in `[begin, end)`.
+ *
+ * @param begin `std::size_t` first position
+ * @param end `std::size_t` one past the last position
+ * @param delta `double` amount to add
+ */
+void segment_tree::add(std::size_t begin, std::size_t end, double delta)
+{
+  assert(begin <= end && end <= n_values_);
+  if (begin == end) {
+    return;
+  }
+  std::size_t n_leaves = nodes_.size() / 2;
+  std::size_t first = begin + n_leaves;
+  std::size_t last = end - 1 + n_leaves;
+  push(first);
+  push(last);
+  std::size_t len = 1;
+  for (std::size_t l = first, r = last + 1; l < r; l /= 2, r /= 2) {
+    if (l & 1) {
+      apply_add(l++, delta, len);
+    }
+    if (r & 1) {
+      apply_add(--r, delta, len);
+    }
+    len *= 2;
+  }
+  rebuild_path(first);
+  rebuild_path(last);
+}
+
+/**
+ * Set every value in `[begin, end)`.
+ *
+ * @param begin `std::size_t` first position
+ * @param end `std::size_t` one past the last position
+ * @param value `double` new value
+ */
+void segment_tree::assign(std::size_t begin, std::size_t end, double value)
+{
+  assert(begin <= end && end <= n_values_);
+  if (begin == end) {
+    return;
+  }
+  std::size_t n_leaves = nodes_.size() / 2;
+  std::size_t first = begin + n_leaves;
+  std::size_t last = end - 1 + n_leaves;
+  push(first);
+  push(last);
+  std::size_t len = 1;
+  for (std::size_t l = first, r = last + 1; l < r; l /= 2, r /= 2) {
+    if (l & 1) {
+      apply_assign(l++, value, len);
+    }
+    if (r & 1) {
+      apply_assign(--r, value, len);
+    }
+    len *= 2;
+  }
+  rebuild_path(first);
+  rebuild_path(last);
+}
+
+/**
+ * Return the sum of values in `[begin, end)`, `0` if empty.
+ *
+ * @param begin `std::size_t` first position
+ * @param end `std::size_t` one past the last position
+ */
+double segment_tree::sum(std::size_t begin, std::size_t end)
+{
+  return query(begin, end).sum;
+}
+
+/**
+ * Return the smallest value in `[begin, end)`, infinity if empty.
+ *
+ * @param begin `std::size_t` first position
+ * @param end `std::size_t` one past the last position
+ */
+double segment_tree::min(std::size_t begin, std::size_t end)
+{
+  return query(begin, end).min;
+}
+
+/**
+ * Return the largest value in `[begin, end)`, negative infinity if empty.
+ *
+ * @param begin `std::size_t` first position
+ * @param end `std::size_t` one past the last position
+ */
+double segment_tree::max(std::size_t begin, std::size_t end)
+{
+  return query(begin, end).max;
+}
+
+/**
+ * Return the value at a position.
+ *
+ * @param i `std::size_t` position
+ */
+double segment_tree::value(std::size_t i) { return query(i, i + 1).sum; }
+
+/**
+ * Return all values, pushing every pending update down to the leaves.
+ */
+double_vector segment_tree::values()
+{
+  std::size_t n_leaves = nodes_.size() / 2;
+  // parents come before children, so tags flow all the way down
+  for (std::size_t level = 1, len = n_leaves; level < n_leaves; level *= 2) {
+    len /= 2;
+    for (std::size_t i = level; i < 2 * level; i++) {
+      push_node(i, len);
+    }
+  }
+  double_vector result(n_values_);
+  for (std::size_t i = 0; i < n_values_; i++) {
+    result[i] = nodes_[n_leaves + i].sum;
+  }
+  return result;
+}
+
+/**
+ * Add to every value under a node, deferring the children via its tag.
+ *
+ * @param i `std::size_t` node index
+ * @param delta `double` amount to add
+ * @param len `std::size_t` number of leaves under the node
+ */
+void segment_tree::apply_add(std::size_t i, double delta, std::size_t len)
+{
+  node& target = nodes_[i];
+  target.sum += delta * len;
+  target.min += delta;
+  target.max += delta;
+  if (i < nodes_.size() / 2) {
+    // an add after an assign folds into the assigned value
+    if (target.assigned) {
+      target.assign += delta;
+    }
+    else {
+      target.add += delta;
+    }
+  }
+}
+
+/**
+ * Set every value under a node, deferring the children via its tag.
+ *
+ * @param i `std::size_t` node index
+ * @param value `double` new value
+ * @param len `std::size_t` number of leaves under the node
+ */
+void segment_tree::apply_assign(std::size_t i, double value, std::size_t len)
+{
+  node& target = nodes_[i];
+  target.sum = value * len;
+  target.min = value;
+  target.max = value;
+  if (i < nodes_.size() / 2) {
+    target.assigned = true;
+    target.assign = value;
+    target.add = 0;
+  }
+}
+
+/**
+ * Push the pending tags of every proper ancestor of a leaf down, top first.
+ *
+ * @param leaf `std::size_t` leaf node index
+ */
+void segment_tree::push(std::size_t leaf)
+{
+  for (std::size_t shift = height_; shift > 0; shift--) {
+    push_node(leaf >> shift, std::size_t(1) << (shift - 1));
+  }
+}
+
+/**
+ * Pass an internal node's pending tag on to its children.
+ *
+ * An assign is applied before an add, matching how `apply_add` folds an add
+ * after an assign into the assigned value.
+ *
+ * @param i `std::size_t` internal node index
+ * @param child_len `std::size_t` number of leaves under each child
+ */
+void segment_tree::push_node(std::size_t i, std::size_t child_len)
+{
+  node& target = nodes_[i];
+  if (target.assigned) {
+    apply_assign(2 * i, target.assign, child_len);
+    apply_assign(2 * i + 1, target.assign, child_len);
+    target.assigned = false;
+  }
+  if (target.add != 0) {
+    apply_add(2 * i, target.add, child_len);
+    apply_add(2 * i + 1, target.add, child_len);
+    target.add = 0;
+  }
+}
+
+/**
+ * Recompute a node's aggregates from its children and its own tag.
+ *
+ * @param i `std::size_t` internal node index
+ * @param len `std::size_t` number of leaves under the node
+ */
+void segment_tree::rebuild(std::size_t i, std::size_t len)
+{
+  node& target = nodes_[i];
+  const node& left = nodes_[2 * i];
+  const node& right = nodes_[2 * i + 1];
+  if (target.assigned) {
+    // the tag overrides everything below, so only the length matters
+    target.sum = target.assign * len;
+    target.min = target.max = target.assign;
+    return;
+  }
+  target.sum = left.sum + right.sum + target.add * len;
+  target.min = std::min(left.min, right.min) + target.add;
+  target.max = std::max(left.max, right.max) + target.add;
+}
+
+/**
+ * Recompute every proper ancestor of a leaf, bottom first.
+ *
+ * @param leaf `std::size_t` leaf node index
+ */
+void segment_tree::rebuild_path(std::size_t leaf)
+{
+  std::size_t len = 2;
+  for (std::size_t i = leaf / 2; i; i /= 2, len *= 2) {
+    rebuild(i, len);
+  }
+}
+
+/**
+ * Return the aggregates of `[begin, end)`.
+ *
+ * @param begin `std::size_t` first position
+ * @param end `std::size_t` one past the last position
+ */
+segment_tree::node segment_tree::query(std::size_t begin, std::size_t end)
+{
+  assert(begin <= end && end <= n_values_);
+  node result{0, inf, -inf, 0, 0, false};
+  if (begin == end) {
+    return result;
+  }
+  std::size_t n_leaves = nodes_.size() / 2;
+  push(begin + n_leaves);
+  push(end - 1 + n_leaves);
+  auto take = [&](const node& part)
+  {
+    result.sum += part.sum;
+    result.min = std::min(result.min, part.min);
+    result.max = std::max(result.max, part.max);
+  };
+  std::size_t l = begin + n_leaves;
+  std::size_t r = end + n_leaves;
+  for (; l < r; l /= 2, r /= 2) {
+    if (l & 1) {
+      take(nodes_[l++]);
+    }
+    if (r & 1) {
+      take(nodes_[--r]);
+    }
+  }
+  return result;
+}
+
+}  // namespace pdcip
@@ -0,0 +1,238 @@
+/**
+ * @file snapshot.cc
+ * @author Derek Huang
+ * @brief C++ source for memory-mapped binary graph snapshots
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "pdcip/cpp/compressed_graph.h"
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/mapped_file.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Magic bytes identifying a snapshot file.
+ */
+constexpr char snapshot_magic[8] = {'P', 'D', 'C', 'I', 'P', 'C', 'S', 'R'};
+
+/**
+ * Byte order mark, read back byte-swapped on a machine of other endianness.
+ */
+constexpr std::uint32_t snapshot_byte_order = 0x01020304;
+
+/**
+ * Round a byte offset up to the snapshot alignment.
+ *
+ * @param pos `std::uint64_t` byte offset
+ */
+constexpr std::uint64_t align_up(std::uint64_t pos)
+{
+  return (pos + snapshot_alignment - 1) / snapshot_alignment *
+    snapshot_alignment;
+}
+
+/**
+ * Write an array at a given byte offset, zero-padding up to it first.
+ *
+ * @param out `std::ofstream&` output stream positioned at or before `pos`
+ * @param pos `std::uint64_t` byte offset to write the array at
+ * @param data `const void*` array to write
+ * @param size `std::uint64_t` number of bytes to write
+ */
+void write_at(
+  std::ofstream& out, std::uint64_t pos, const void* data, std::uint64_t size)
+{
+  static const char zeros[snapshot_alignment] = {};
+  auto current = static_cast<std::uint64_t>(out.tellp());
+  out.write(zeros, static_cast<std::streamsize>(pos - current));
+  out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+/**
+ * Return `true` if an array lies inside the file at an aligned offset.
+ *
+ * @param pos `std::uint64_t` byte offset of the array
+ * @param size `std::uint64_t` size of the array in bytes
+ * @param file_size `std::uint64_t` size of the file in bytes
+ */
+bool valid_section(
+  std::uint64_t pos, std::uint64_t size, std::uint64_t file_size)
+{
+  return pos % snapshot_alignment == 0 && pos >= sizeof(snapshot_header) &&
+    pos <= file_size && size <= file_size - pos;
+}
+
+}  // namespace
+
+/**
+ * Write a graph to a binary snapshot file in one sequential pass.
+ *
+ * The file holds a `snapshot_header` followed by the row offsets, edge
+ * targets, edge weights if the graph is weighted, and vertex values, each
+ * stored in native layout at a 64-byte aligned offset so `open_snapshot` can
+ * use them in place.
+ *
+ * @param graph `const csr_graph&` graph to write
+ * @param path `const std::string&` path of the file to write
+ * @returns `true` on success, `false` if the file could not be written
+ */
+bool write_snapshot(const csr_graph& graph, const std::string& path)
+{
+  std::uint64_t n_vertices = graph.n_vertices();
+  std::uint64_t n_edges = graph.n_edges();
+  snapshot_header header = {};
+  std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+  header.version = snapshot_version;
+  header.byte_order = snapshot_byte_order;
+  header.edge_index_size = sizeof(edge_index);
+  header.vertex_index_size = sizeof(vertex_index);
+  header.n_vertices = n_vertices;
+  header.n_edges = n_edges;
+  // lay out the sections up front so the file is written front to back
+  header.offsets_pos = align_up(sizeof(snapshot_header));
+  header.targets_pos = align_up(
+    header.offsets_pos + (n_vertices + 1) * sizeof(edge_index)
+  );
+  std::uint64_t pos = align_up(
+    header.targets_pos + n_edges * sizeof(vertex_index)
+  );
+  if (graph.weighted()) {
+    header.weights_pos = pos;
+    pos = align_up(pos + n_edges * sizeof(double));
+  }
+  header.values_pos = pos;
+  header.file_size = pos + n_vertices * sizeof(double);
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  write_at(
+    out,
+    header.offsets_pos,
+    graph.offsets(),
+    (n_vertices + 1) * sizeof(edge_index)
+  );
+  write_at(
+    out, header.targets_pos, graph.targets(), n_edges * sizeof(vertex_index)
+  );
+  if (graph.weighted()) {
+    write_at(
+      out, header.weights_pos, graph.weights(), n_edges * sizeof(double)
+    );
+  }
+  write_at(out, header.values_pos, graph.values(), n_vertices * sizeof(double));
+  out.close();
+  return static_cast<bool>(out);
+}
+
+/**
+ * Open a binary snapshot file as a read-only graph without parsing.
+ *
+ * The file is memory-mapped and the returned graph points straight into the
+ * mapping, so opening costs `O(1)` regardless of graph size and pages are
+ * only read as algorithms touch them. The mapping is shared, so every process
+ * opening the same snapshot uses one copy in the page cache. The mapping
+ * lives as long as the graph or any copy of it.
+ *
+ * Only the header and section bounds are validated, so the array contents
+ * are trusted to be what `write_snapshot` produced.
+ *
+ * @param path `const std::string&` path of the snapshot file
+ * @returns `std::optional<csr_graph>`, empty if the file could not be mapped,
+ *    is not a snapshot, or was written with another version, byte order, or
+ *    index widths
+ */
+std::optional<csr_graph> open_snapshot(const std::string& path)
+{
+  auto file = std::make_shared<mapped_file>(path);
+  if (!file->is_open() || file->size() < sizeof(snapshot_header)) {
+    return std::nullopt;
+  }
+  snapshot_header header;
+  std::memcpy(&header, file->data(), sizeof(header));
+  std::uint64_t file_size = file->size();
+  std::uint64_t n_vertices = header.n_vertices;
+  std::uint64_t n_edges = header.n_edges;
+  if (
+    std::memcmp(header.magic, snapshot_magic, sizeof(header.magic)) ||
+    header.version != snapshot_version ||
+    header.byte_order != snapshot_byte_order ||
+    header.edge_index_size != sizeof(edge_index) ||
+    header.vertex_index_size != sizeof(vertex_index) ||
+    header.file_size != file_size ||
+    n_vertices >= file_size ||
+    n_edges >= file_size ||
+    !valid_section(
+      header.offsets_pos, (n_vertices + 1) * sizeof(edge_index), file_size
+    ) ||
+    !valid_section(
+      header.targets_pos, n_edges * sizeof(vertex_index), file_size
+    ) ||
+    !valid_section(header.values_pos, n_vertices * sizeof(double), file_size)
+  ) {
+    return std::nullopt;
+  }
+  if (
+    header.weights_pos &&
+    !valid_section(header.weights_pos, n_edges * sizeof(double), file_size)
+  ) {
+    return std::nullopt;
+  }
+  const char* data = file->data();
+  auto offsets = reinterpret_cast<const edge_index*>(data + header.offsets_pos);
+  if (offsets[0] != 0 || offsets[n_vertices] != n_edges) {
+    return std::nullopt;
+  }
+  return csr_graph(
+    static_cast<std::size_t>(n_vertices),
+    static_cast<std::size_t>(n_edges),
+    offsets,
+    reinterpret_cast<const vertex_index*>(data + header.targets_pos),
+    (header.weights_pos) ?
+      reinterpret_cast<const double*>(data + header.weights_pos) : nullptr,
+    reinterpret_cast<const double*>(data + header.values_pos),
+    std::move(file)
+  );
+}
+
+/**
+ * Compress a binary snapshot file straight from its mapping.
+ *
+ * The compressing passes read the rows through the mapping, so the
+ * uncompressed graph is only ever paged in from the file and never copied
+ * onto the heap. The mapping is released before returning, leaving only the
+ * compressed graph in memory. Rows must be sorted, as in any snapshot
+ * written from a `csr_graph`.
+ *
+ * @param path `const std::string&` path of the snapshot file
+ * @param n_threads `std::size_t` number of threads, `0` for default
+ * @returns `std::optional<compressed_graph>`, empty if `open_snapshot` would
+ *    reject the file
+ */
+std::optional<compressed_graph> open_compressed_snapshot(
+  const std::string& path, std::size_t n_threads)
+{
+  std::optional<csr_graph> mapped = open_snapshot(path);
+  if (!mapped) {
+    return std::nullopt;
+  }
+  return compressed_graph(*mapped, n_threads);
+}
+
+}  // namespace pdcip
@@ -0,0 +1,565 @@
+/**
+ * @file tree_diff.cc
+ * @author Derek Huang
+ * @brief C++ source for diffing and patching trees
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/tree_diff.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/merkle.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+
+namespace pdcip {
+
+namespace {
+
+/**
+ * Node number standing for no node, e.g. the parent of the root.
+ */
+constexpr vertex_index no_node = std::numeric_limits<vertex_index>::max();
+
+/**
+ * How far a source node has been matched to the target while diffing.
+ *
+ * `paired` nodes correspond to a target node but their subtrees may differ,
+ * `whole` subtrees reappear unchanged in the target, and `split` subtrees
+ * had a descendant taken as `whole`, so they no longer match their hash.
+ */
+enum match_state : std::uint8_t {unmatched, paired, whole, split};
+
+/**
+ * How far the walk up from a node towards the root has checked it.
+ *
+ * `walking` nodes are on the current walk, so reaching one again is a cycle,
+ * and `cleared` nodes are known to end at the root or a removed subtree.
+ */
+enum walk_state : std::uint8_t {unseen, walking, cleared};
+
+/**
+ * Nodes of a tree in `tree::dfs` order with their parents and positions.
+ */
+struct dfs_layout {
+  tree_ptr_vector nodes;
+  vertex_index_vector parents;
+  vertex_index_vector positions;
+};
+
+/**
+ * Lay out a tree in `tree::dfs` order without recursion.
+ *
+ * A node is numbered after all of its descendants, so the subtree of each
+ * child is the contiguous range of numbers ending at the child, and walking
+ * back from a node by subtree sizes visits its children last to first.
+ *
+ * @param root `const tree_ptr&` root of the tree
+ * @returns `std::optional<dfs_layout>`, empty if a child is `nullptr`
+ */
+std::optional<dfs_layout> layout_tree(const tree_ptr& root)
+{
+  struct frame {
+    tree_ptr node;
+    std::size_t next;
+    vertex_index start;
+  };
+  dfs_layout layout;
+  vertex_index_vector sizes;
+  std::vector<frame> stack{{root, 0, 0}};
+  while (!stack.empty()) {
+    frame& top = stack.back();
+    std::size_t n_slots = child_slots(*top.node);
+    if (top.next < n_slots) {
+      const tree_ptr& child = (*top.node->children())[top.next++];
+      if (!child) {
+        return std::nullopt;
+      }
+      auto start = static_cast<vertex_index>(layout.nodes.size());
+      stack.push_back({child, 0, start});
+      continue;
+    }
+    auto id = static_cast<vertex_index>(layout.nodes.size());
+    for (vertex_index end = id; end > top.start; end -= sizes[end - 1]) {
+      layout.parents[end - 1] = id;
+      layout.positions[end - 1] = static_cast<vertex_index>(--n_slots);
+    }
+    sizes.push_back(id - top.start + 1);
+    layout.nodes.push_back(std::move(top.node));
+    layout.parents.push_back(no_node);
+    layout.positions.push_back(0);
+    stack.pop_back();
+  }
+  return layout;
+}
+
+/**
+ * Return which elements form a longest increasing subsequence.
+ *
+ * @param values `const vertex_index_vector&` distinct values
+ * @returns `std::vector<std::uint8_t>` with `1` for elements of the
+ *    subsequence and `0` otherwise
+ */
+std::vector<std::uint8_t> increasing_run(const vertex_index_vector& values)
+{
+  // tails[k] is the element ending the best subsequence of length k + 1
+  std::vector<std::size_t> tails;
+  std::vector<std::size_t> previous(values.size(), values.size());
+  for (std::size_t i = 0; i < values.size(); i++) {
+    auto it = std::lower_bound(
+      tails.begin(),
+      tails.end(),
+      values[i],
+      [&](std::size_t j, vertex_index value) { return values[j] < value; }
+    );
+    if (it != tails.begin()) {
+      previous[i] = *(it - 1);
+    }
+    if (it == tails.end()) {
+      tails.push_back(i);
+    }
+    else {
+      *it = i;
+    }
+  }
+  std::vector<std::uint8_t> result(values.size(), 0);
+  std::size_t i = tails.empty() ? values.size() : tails.back();
+  for (; i < values.size(); i = previous[i]) {
+    result[i] = 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+/**
+ * Return an edit script turning one tree into another.
+ *
+ * Both trees are Merkle hashed, and matching proceeds top-down from the
+ * roots, which always correspond. For each pair of corresponding nodes, a
+ * target child first takes an unchanged subtree among the source node's
+ * children with the same hash, then an unchanged subtree with more than one
+ * node from anywhere in the source, which becomes a move, and otherwise the
+ * next left over source child in order, which is then diffed in turn. Target
+ * nodes still without a match are inserted, and left over source children
+ * are removed. Children kept under the same parent stay in place if they are
+ * in a longest run whose source order is preserved and are moved otherwise.
+ *
+ * Subtrees with equal hashes are never descended into, so apart from the
+ * linear hashing pass the work depends on the size of the change. Matching
+ * is greedy, so the script is small but not guaranteed to be the shortest.
+ *
+ * @note Trees must not have `nullptr` children or nodes shared between them.
+ *
+ * @param source `const tree_ptr&` root of the tree to edit
+ * @param target `const tree_ptr&` root of the tree to edit it into
+ */
+tree_patch diff_trees(const tree_ptr& source, const tree_ptr& target)
+{
+  assert(source && target);
+  merkle_hashes source_hashes(source);
+  merkle_hashes target_hashes(target);
+  tree_patch patch{
+    source_hashes.size(),
+    source_hashes.root_hash(),
+    target_hashes.root_hash(),
+    {}
+  };
+  if (patch.source_hash == patch.target_hash) {
+    return patch;
+  }
+  std::optional<dfs_layout> source_layout = layout_tree(source);
+  assert(source_layout && "nullptr children are not supported");
+  dfs_layout& layout = *source_layout;
+  std::size_t n_source = layout.nodes.size();
+  // source numbers by address, and chains of non-leaf source nodes by hash.
+  // leaves are no cheaper to move than to insert, so they are never moved
+  flat_hash_map<vertex_index> ids;
+  flat_hash_map<vertex_index> first_by_hash;
+  vertex_index_vector next_by_hash(n_source, no_node);
+  ids.reserve(n_source);
+  for (vertex_index i = 0; i < n_source; i++) {
+    const tree* node = layout.nodes[i].get();
+    ids.emplace(node_key(node)).first = i;
+    if (child_slots(*node)) {
+      auto slot = first_by_hash.emplace(source_hashes.hash(node));
+      next_by_hash[i] = slot.second ? no_node : slot.first;
+      slot.first = i;
+    }
+  }
+  std::vector<std::uint8_t> states(n_source, unmatched);
+  // a source node can still be taken whole if it is unmatched and not inside
+  // a whole subtree. once false this stays false, so chains can drop it
+  auto available = [&](vertex_index node)
+  {
+    if (states[node] != unmatched) {
+      return false;
+    }
+    vertex_index up = layout.parents[node];
+    for (; up != no_node && states[up] != paired; up = layout.parents[up]) {
+      if (states[up] == whole) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto take_whole = [&](vertex_index node)
+  {
+    states[node] = whole;
+    vertex_index up = layout.parents[node];
+    for (; up != no_node && states[up] == unmatched; up = layout.parents[up]) {
+      states[up] = split;
+    }
+  };
+  auto find_whole = [&](const tree* node)
+  {
+    vertex_index* head = first_by_hash.find(target_hashes.hash(node));
+    if (!head) {
+      return no_node;
+    }
+    while (*head != no_node && !available(*head)) {
+      *head = next_by_hash[*head];
+    }
+    return *head;
+  };
+  auto add_edit = [&](
+    tree_edit_type type,
+    vertex_index node,
+    vertex_index parent,
+    std::size_t position,
+    double value)
+  {
+    patch.edits.push_back(
+      {type, node, parent, static_cast<vertex_index>(position), value}
+    );
+  };
+  // target nodes paired with a source node or inserted as a new node
+  struct diff_item {
+    const tree* target;
+    vertex_index node;
+    bool inserted;
+  };
+  auto root_id = static_cast<vertex_index>(n_source - 1);
+  std::vector<diff_item> queue{{target.get(), root_id, false}};
+  states[queue[0].node] = paired;
+  auto next_id = static_cast<vertex_index>(n_source);
+  vertex_index_vector leftovers;
+  for (std::size_t i = 0; i < queue.size(); i++) {
+    auto [node, id, inserted] = queue[i];
+    std::size_t n_slots = child_slots(*node);
+    const tree_ptr_vector* children = node->children().get();
+    vertex_index_vector matches(n_slots, no_node);
+    if (!inserted) {
+      const tree& peer = *layout.nodes[id];
+      if (!same_node_value(peer.value(), node->value())) {
+        add_edit(tree_edit_type::update, id, 0, 0, node->value());
+      }
+      // number the source children and chain them by hash
+      std::size_t n_peer_slots = child_slots(peer);
+      vertex_index_vector peer_ids(n_peer_slots);
+      vertex_index_vector next_peer(n_peer_slots, no_node);
+      flat_hash_map<vertex_index> first_peer;
+      first_peer.reserve(n_peer_slots);
+      for (std::size_t k = n_peer_slots; k-- > 0; ) {
+        const tree* child = (*peer.children())[k].get();
+        peer_ids[k] = *ids.find(node_key(child));
+        if (states[peer_ids[k]] != unmatched) {
+          continue;
+        }
+        auto slot = first_peer.emplace(source_hashes.hash(child));
+        next_peer[k] = slot.second ? no_node : slot.first;
+        slot.first = static_cast<vertex_index>(k);
+      }
+      for (std::size_t j = 0; j < n_slots; j++) {
+        vertex_index* head = first_peer.find(
+          target_hashes.hash((*children)[j].get())
+        );
+        while (head && *head != no_node) {
+          vertex_index k = *head;
+          *head = next_peer[k];
+          if (states[peer_ids[k]] == unmatched) {
+            matches[j] = peer_ids[k];
+            take_whole(matches[j]);
+            break;
+          }
+        }
+      }
+      for (std::size_t j = 0; j < n_slots; j++) {
+        if (matches[j] == no_node) {
+          matches[j] = find_whole((*children)[j].get());
+          if (matches[j] != no_node) {
+            take_whole(matches[j]);
+          }
+        }
+      }
+      // pair what is left in order. split source children can be paired too,
+      // as what remains of them is diffed like any other subtree
+      std::size_t k = 0;
+      for (std::size_t j = 0; j < n_slots; j++) {
+        if (matches[j] != no_node) {
+          continue;
+        }
+        while (
+          k < n_peer_slots &&
+          states[peer_ids[k]] != unmatched && states[peer_ids[k]] != split
+        ) {
+          k++;
+        }
+        if (k == n_peer_slots) {
+          break;
+        }
+        matches[j] = peer_ids[k++];
+        states[matches[j]] = paired;
+        queue.push_back({(*children)[j].get(), matches[j], false});
+      }
+      leftovers.insert(leftovers.end(), peer_ids.begin(), peer_ids.end());
+    }
+    else {
+      for (std::size_t j = 0; j < n_slots; j++) {
+        matches[j] = find_whole((*children)[j].get());
+        if (matches[j] != no_node) {
+          take_whole(matches[j]);
+        }
+      }
+    }
+    // children already under this node stay if their order is kept
+    vertex_index_vector kept_positions;
+    for (std::size_t j = 0; j < n_slots; j++) {
+      if (
+        !inserted && matches[j] != no_node && layout.parents[matches[j]] == id
+      ) {
+        kept_positions.push_back(layout.positions[matches[j]]);
+      }
+    }
+    std::vector<std::uint8_t> stays = increasing_run(kept_positions);
+    std::size_t n_kept = 0;
+    for (std::size_t j = 0; j < n_slots; j++) {
+      const tree* child = (*children)[j].get();
+      if (matches[j] == no_node) {
+        add_edit(tree_edit_type::insert, next_id, id, j, child->value());
+        queue.push_back({child, next_id++, true});
+      }
+      else if (
+        !inserted && layout.parents[matches[j]] == id && stays[n_kept++]
+      ) {
+        continue;
+      }
+      else {
+        add_edit(tree_edit_type::move, matches[j], id, j, 0);
+      }
+    }
+  }
+  for (vertex_index id : leftovers) {
+    if (states[id] == unmatched || states[id] == split) {
+      add_edit(tree_edit_type::remove, id, 0, 0, 0);
+    }
+  }
+  return patch;
+}
+
+/**
+ * Apply an edit script from `diff_trees` to a tree in place.
+ *
+ * The tree must be equal to the source the patch was made from, which can
+ * be checked beforehand by comparing `merkle_hashes(root).root_hash()` to
+ * `patch.source_hash`, and the result can be checked against
+ * `patch.target_hash`. Every edit is checked against the tree before
+ * anything is changed: node numbers must be in range, inserts numbered in
+ * order, no node detached twice or the root detached at all, positions
+ * under each parent distinct and within its final number of children, and
+ * no node moved under its own subtree.
+ *
+ * @note Trees must consist of plain `tree` nodes without `nullptr` children.
+ *    Trees with subclass nodes such as `augmented_tree` or `binary_tree` are
+ *    refused, as inserted nodes are always created as `tree`.
+ *
+ * Nodes to remove or move are detached from their parents, after which
+ * value updates, inserts, and reattachments are applied in order. Each
+ * parent whose children change is given a new child vector once, merging
+ * its remaining children with the nodes attached to it, so children vectors
+ * shared with other trees are left untouched.
+ *
+ * @param root `const tree_ptr&` root of the tree to patch
+ * @param patch `const tree_patch&` edit script from `diff_trees`
+ * @returns `true` if the patch was applied, `false` if it does not fit the
+ *    tree, in which case the tree is unchanged
+ */
+bool apply_tree_patch(const tree_ptr& root, const tree_patch& patch)
+{
+  if (!root) {
+    return false;
+  }
+  std::optional<dfs_layout> layout = layout_tree(root);
+  if (!layout || layout->nodes.size() != patch.source_size) {
+    return false;
+  }
+  std::size_t n_source = layout->nodes.size();
+  tree_ptr_vector& nodes = layout->nodes;
+  const vertex_index_vector& parents = layout->parents;
+  for (const tree_ptr& node : nodes) {
+    const tree& current = *node;
+    if (typeid(current) != typeid(tree)) {
+      return false;
+    }
+  }
+  // nodes attached to each parent, in order of their final positions
+  struct attachment {
+    vertex_index parent;
+    vertex_index position;
+    vertex_index node;
+  };
+  std::vector<attachment> attachments;
+  flat_hash_map<std::uint8_t> detached;
+  vertex_index_vector touched;
+  std::size_t n_nodes = n_source;
+  for (const tree_edit& edit : patch.edits) {
+    switch (edit.type) {
+      case tree_edit_type::update:
+        if (edit.node >= n_nodes) {
+          return false;
+        }
+        break;
+      case tree_edit_type::insert:
+        if (edit.node != n_nodes || edit.parent >= n_nodes) {
+          return false;
+        }
+        n_nodes++;
+        attachments.push_back({edit.parent, edit.position, edit.node});
+        touched.push_back(edit.parent);
+        break;
+      case tree_edit_type::move:
+      case tree_edit_type::remove:
+        if (
+          edit.node >= n_source || parents[edit.node] == no_node ||
+          !detached.emplace(node_key(nodes[edit.node].get())).second
+        ) {
+          return false;
+        }
+        touched.push_back(parents[edit.node]);
+        if (edit.type == tree_edit_type::move) {
+          if (edit.parent >= n_nodes) {
+            return false;
+          }
+          attachments.push_back({edit.parent, edit.position, edit.node});
+          touched.push_back(edit.parent);
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+  std::sort(
+    attachments.begin(),
+    attachments.end(),
+    [](const attachment& first, const attachment& second)
+    {
+      return first.parent < second.parent || (
+        first.parent == second.parent && first.position < second.position
+      );
+    }
+  );
+  std::sort(touched.begin(), touched.end());
+  touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+  // attached positions under each parent must fill slots of its final
+  // children, which then leaves exactly the right slots for the others
+  std::vector<std::size_t> n_kept(touched.size(), 0);
+  auto attached = attachments.begin();
+  for (std::size_t i = 0; i < touched.size(); i++) {
+    vertex_index parent = touched[i];
+    if (parent < n_source && nodes[parent]->children()) {
+      for (const tree_ptr& child : *nodes[parent]->children()) {
+        n_kept[i] += !detached.contains(node_key(child.get()));
+      }
+    }
+    auto first = attached;
+    while (attached != attachments.end() && attached->parent == parent) {
+      attached++;
+    }
+    std::size_t n_children = n_kept[i] + (attached - first);
+    for (auto it = first; it != attached; ++it) {
+      if (
+        it->position >= n_children ||
+        (it != first && it->position == (it - 1)->position)
+      ) {
+        return false;
+      }
+    }
+  }
+  // every attached node must still hang off the root or a removed subtree,
+  // found by walking final parents and remembering nodes already cleared
+  vertex_index_vector final_parents(n_nodes, no_node);
+  std::copy(parents.begin(), parents.end(), final_parents.begin());
+  for (const tree_edit& edit : patch.edits) {
+    if (edit.type == tree_edit_type::remove) {
+      final_parents[edit.node] = no_node;
+    }
+  }
+  for (const attachment& attach : attachments) {
+    final_parents[attach.node] = attach.parent;
+  }
+  std::vector<std::uint8_t> states(n_nodes, unseen);
+  vertex_index_vector path;
+  for (const attachment& attach : attachments) {
+    vertex_index node = attach.node;
+    for (; node != no_node && states[node] == unseen; ) {
+      states[node] = walking;
+      path.push_back(node);
+      node = final_parents[node];
+    }
+    if (node != no_node && states[node] == walking) {
+      return false;
+    }
+    for (vertex_index visited : path) {
+      states[visited] = cleared;
+    }
+    path.clear();
+  }
+  // the patch fits, so apply it
+  for (const tree_edit& edit : patch.edits) {
+    if (edit.type == tree_edit_type::update) {
+      nodes[edit.node]->set_value(edit.value);
+    }
+    else if (edit.type == tree_edit_type::insert) {
+      nodes.push_back(std::make_shared<tree>(edit.value));
+    }
+  }
+  attached = attachments.begin();
+  for (vertex_index parent : touched) {
+    tree_ptr_vector remaining;
+    if (nodes[parent]->children()) {
+      for (const tree_ptr& child : *nodes[parent]->children()) {
+        if (!detached.contains(node_key(child.get()))) {
+          remaining.push_back(child);
+        }
+      }
+    }
+    auto children = std::make_shared<tree_ptr_vector>();
+    auto kept = remaining.begin();
+    for (; attached != attachments.end(); ++attached) {
+      if (attached->parent != parent) {
+        break;
+      }
+      while (children->size() < attached->position) {
+        children->push_back(*kept++);
+      }
+      children->push_back(nodes[attached->node]);
+    }
+    children->insert(children->end(), kept, remaining.end());
+    nodes[parent]->set_children(std::move(children));
+  }
+  return true;
+}
+
+}  // namespace pdcip
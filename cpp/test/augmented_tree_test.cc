@@ -0,0 +1,200 @@
+/**
+ * @file augmented_tree_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for trees caching aggregates of their subtrees
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/augmented_tree.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/merkle.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+using augmented_node = augmented_tree<>;
+using augmented_binary_node = augmented_tree<binary_tree>;
+
+/**
+ * Test fixture with a random multi-child augmented tree.
+ *
+ * Children are attached bottom-up and top-down in turn, so both orders of
+ * building exercise propagation.
+ */
+class AugmentedTreeTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the tree.
+   */
+  AugmentedTreeTest() : rng_(73)
+  {
+    for (std::size_t i = 0; i < n_nodes_; i++) {
+      nodes_.push_back(
+        std::make_shared<augmented_node>(static_cast<double>(rng_() % 100))
+      );
+    }
+    std::vector<tree_ptr_vector> children(n_nodes_);
+    for (std::size_t i = 1; i < n_nodes_; i++) {
+      children[rng_() % i].push_back(nodes_[i]);
+    }
+    for (std::size_t i = 0; i < n_nodes_; i++) {
+      std::size_t v = (i % 2) ? i : n_nodes_ - i;
+      v = (v == n_nodes_) ? 0 : v;
+      nodes_[v]->set_children(
+        std::make_shared<tree_ptr_vector>(children[v])
+      );
+    }
+  }
+
+  /**
+   * Check that every cached aggregate matches a full recomputation.
+   */
+  void check_aggregates() const
+  {
+    for (const auto& node : nodes_) {
+      ASSERT_EQ(node->recompute(), node->aggregate());
+    }
+  }
+
+  static constexpr std::size_t n_nodes_ = 200;
+  std::mt19937_64 rng_;
+  std::vector<std::shared_ptr<augmented_node>> nodes_;
+};
+
+/**
+ * Test that the aggregates are right after building the tree.
+ */
+TEST_F(AugmentedTreeTest, BuildTest)
+{
+  check_aggregates();
+  ASSERT_EQ(nullptr, nodes_[0]->parent());
+  ASSERT_EQ(n_nodes_, nodes_[0]->aggregate().count);
+  for (std::size_t i = 1; i < n_nodes_; i++) {
+    ASSERT_NE(nullptr, nodes_[i]->parent());
+  }
+}
+
+/**
+ * Test that value updates and subtree moves keep the aggregates right.
+ */
+TEST_F(AugmentedTreeTest, MutationTest)
+{
+  for (std::size_t i = 0; i < 300; i++) {
+    auto& node = nodes_[rng_() % n_nodes_];
+    if (i % 3) {
+      node->set_value(static_cast<double>(rng_() % 1000) - 500);
+      continue;
+    }
+    // detach a random non-root node and hang it under the root instead
+    augmented_node* parent = node->parent();
+    if (!parent) {
+      continue;
+    }
+    auto siblings = std::make_shared<tree_ptr_vector>();
+    for (const tree_ptr& child : *parent->children()) {
+      if (child != node) {
+        siblings->push_back(child);
+      }
+    }
+    parent->set_children(siblings);
+    ASSERT_EQ(nullptr, node->parent());
+    nodes_[0]->set_children(
+      [&]
+      {
+        auto children = std::make_shared<tree_ptr_vector>(
+          *nodes_[0]->children()
+        );
+        children->push_back(node);
+        return children;
+      }()
+    );
+    ASSERT_EQ(nodes_[0].get(), node->parent());
+  }
+  check_aggregates();
+  ASSERT_EQ(n_nodes_, nodes_[0]->aggregate().count);
+}
+
+/**
+ * Test augmented binary trees through `set_left` and `set_right`.
+ */
+TEST_F(AugmentedTreeTest, BinaryTreeTest)
+{
+  auto root = std::make_shared<augmented_binary_node>(5);
+  auto left = std::make_shared<augmented_binary_node>(3);
+  auto right = std::make_shared<augmented_binary_node>(8);
+  auto leaf = std::make_shared<augmented_binary_node>();
+  root->set_left(left);
+  root->set_right(right);
+  right->set_right(leaf);
+  // empty nodes are not counted
+  ASSERT_EQ(3, root->aggregate().count);
+  leaf->set_value(10);
+  ASSERT_EQ(4, root->aggregate().count);
+  ASSERT_EQ(26, root->aggregate().sum);
+  ASSERT_EQ(3, root->aggregate().min);
+  ASSERT_EQ(10, root->aggregate().max);
+  root->set_left(nullptr);
+  ASSERT_EQ(nullptr, left->parent());
+  ASSERT_EQ(root.get(), right->parent());
+  ASSERT_EQ(23, root->aggregate().sum);
+  ASSERT_EQ(5, root->aggregate().min);
+  ASSERT_EQ(root->recompute(), root->aggregate());
+}
+
+/**
+ * Test that cached hashes track mutations and match `merkle_hashes`.
+ */
+TEST_F(AugmentedTreeTest, HashTest)
+{
+  std::uint64_t before = nodes_[0]->hash();
+  ASSERT_EQ(merkle_hashes(nodes_[0]).root_hash(), before);
+  double old_value = nodes_[150]->value();
+  nodes_[150]->set_value(old_value + 1);
+  ASSERT_NE(before, nodes_[0]->hash());
+  ASSERT_EQ(merkle_hashes(nodes_[0]).root_hash(), nodes_[0]->hash());
+  // a structurally equal copy hashes equally and diffs to the one change
+  std::vector<std::shared_ptr<augmented_node>> copies;
+  for (const auto& node : nodes_) {
+    copies.push_back(std::make_shared<augmented_node>(node->value()));
+  }
+  for (std::size_t i = 0; i < n_nodes_; i++) {
+    auto children = std::make_shared<tree_ptr_vector>();
+    for (const tree_ptr& child : *nodes_[i]->children()) {
+      for (std::size_t j = 0; j < n_nodes_; j++) {
+        if (nodes_[j] == child) {
+          children->push_back(copies[j]);
+        }
+      }
+    }
+    copies[i]->set_children(children);
+  }
+  ASSERT_EQ(nodes_[0]->hash(), copies[0]->hash());
+  ASSERT_TRUE(nodes_[0]->diff(*copies[0]).empty());
+  copies[150]->set_value(old_value);
+  changed_node_vector changes = nodes_[0]->diff(*copies[0]);
+  ASSERT_EQ(1, changes.size());
+  ASSERT_EQ(nodes_[150].get(), changes[0].first);
+  ASSERT_EQ(copies[150].get(), changes[0].second);
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,93 @@
+/**
+ * @file betweenness_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for betweenness centrality in betweenness.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/betweenness.h"
+
+#include <cstddef>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test betweenness on an undirected path graph 0 - 1 - 2 - 3 - 4.
+ */
+TEST(BetweennessTest, PathTest)
+{
+  csr_graph graph = csr_graph(
+    5, vertex_index_vector({0, 1, 2, 3}), vertex_index_vector({1, 2, 3, 4})
+  ).symmetrize();
+  // symmetric form counts each undirected path from both ends
+  ASSERT_EQ(
+    double_vector({0, 6, 8, 6, 0}), betweenness_centrality(graph, 2)
+  );
+  // sampling every vertex gives the exact scores
+  ASSERT_EQ(
+    double_vector({0, 6, 8, 6, 0}), approximate_betweenness(graph, 5, 3, 2)
+  );
+}
+
+/**
+ * Test that weighted graphs follow the cheapest paths.
+ */
+TEST(BetweennessTest, WeightedTest)
+{
+  // 0 -> 2 directly costs 3 but only 2 via 1. 3 -> {1, 2} splits the path
+  // 3 -> 1 -> 2 with cost 2 and the direct 3 -> 2 with cost 2
+  csr_graph graph(
+    4,
+    vertex_index_vector({0, 1, 0, 3, 3}),
+    vertex_index_vector({1, 2, 2, 1, 2}),
+    double_vector({1, 1, 3, 1, 2})
+  );
+  ASSERT_EQ(double_vector({0, 1.5, 0, 0}), betweenness_centrality(graph));
+}
+
+/**
+ * Test that sampled betweenness is close to the exact scores on average.
+ */
+TEST(BetweennessTest, SampledTest)
+{
+  std::size_t n_vertices = 300;
+  std::mt19937 rng(23);
+  std::uniform_int_distribution<vertex_index> dist(0, n_vertices - 1);
+  vertex_index_vector sources(1500);
+  vertex_index_vector targets(sources.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    sources[i] = dist(rng);
+    targets[i] = dist(rng);
+  }
+  csr_graph graph = csr_graph(n_vertices, sources, targets).symmetrize();
+  double_vector exact = betweenness_centrality(graph, 4);
+  double_vector single_thread = betweenness_centrality(graph, 1);
+  double exact_total = 0;
+  double sampled_total = 0;
+  double_vector sampled = approximate_betweenness(graph, 150, 7, 4);
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    ASSERT_NEAR(single_thread[v], exact[v], 1e-6);
+    exact_total += exact[v];
+    sampled_total += sampled[v];
+  }
+  ASSERT_NEAR(1, sampled_total / exact_total, 0.1);
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
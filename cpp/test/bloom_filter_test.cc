@@ -0,0 +1,83 @@
+/**
+ * @file bloom_filter_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the cache-line blocked Bloom filter
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/bloom_filter.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/flat_hash_map.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture for `blocked_bloom_filter` tests.
+ *
+ * Holds a filter sized for `n_keys_` keys, filled with the hashes of the
+ * even integers below `2 * n_keys_`.
+ */
+class BlockedBloomFilterTest : public ::testing::Test {
+protected:
+  BlockedBloomFilterTest() : filter_(n_keys_)
+  {
+    for (std::uint64_t key = 0; key < 2 * n_keys_; key += 2) {
+      filter_.insert(mix_hash(key));
+    }
+  }
+
+  static constexpr std::size_t n_keys_ = 10000;
+  blocked_bloom_filter filter_;
+};
+
+/**
+ * Test that the filter is sized in whole cache lines.
+ */
+TEST_F(BlockedBloomFilterTest, SizeTest)
+{
+  // 16 bits per key, 512 bits per block
+  ASSERT_EQ((n_keys_ * 16 + 511) / 512, filter_.n_blocks());
+  ASSERT_EQ(64 * filter_.n_blocks(), filter_.n_bytes());
+  ASSERT_EQ(1, blocked_bloom_filter().n_blocks());
+}
+
+/**
+ * Test that inserted keys are always found and few others are.
+ */
+TEST_F(BlockedBloomFilterTest, FalsePositiveTest)
+{
+  std::size_t n_false = 0;
+  for (std::uint64_t key = 0; key < 2 * n_keys_; key += 2) {
+    ASSERT_TRUE(filter_.contains(mix_hash(key)));
+    n_false += filter_.contains(mix_hash(key + 1));
+  }
+  ASSERT_LT(n_false, n_keys_ / 100);
+}
+
+/**
+ * Test that clearing removes every key.
+ */
+TEST_F(BlockedBloomFilterTest, ClearTest)
+{
+  filter_.clear();
+  for (std::uint64_t key = 0; key < 2 * n_keys_; key += 2) {
+    ASSERT_FALSE(filter_.contains(mix_hash(key)));
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
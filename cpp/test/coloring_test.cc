@@ -0,0 +1,144 @@
+/**
+ * @file coloring_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for graph coloring in coloring.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/coloring.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/kcore.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test that a complete graph needs one color per vertex.
+ */
+TEST(ColoringTest, CompleteTest)
+{
+  vertex_index_vector sources;
+  vertex_index_vector targets;
+  for (vertex_index u = 0; u < 5; u++) {
+    for (vertex_index v = u + 1; v < 5; v++) {
+      sources.push_back(u);
+      targets.push_back(v);
+    }
+  }
+  csr_graph graph = csr_graph(5, sources, targets).symmetrize();
+  vertex_coloring coloring = greedy_coloring(graph);
+  ASSERT_EQ(5U, coloring.n_colors);
+  ASSERT_TRUE(valid_coloring(graph, coloring.colors));
+  coloring = parallel_coloring(graph, 3);
+  ASSERT_EQ(5U, coloring.n_colors);
+  ASSERT_TRUE(valid_coloring(graph, coloring.colors));
+}
+
+/**
+ * Test that smallest-last ordering two-colors a tree.
+ *
+ * Trees are 1-degenerate, so any degeneracy ordering needs only two colors.
+ * Vertex labels are shuffled so natural order does not follow the tree.
+ */
+TEST(ColoringTest, TreeTest)
+{
+  std::size_t n_vertices = 1000;
+  std::mt19937 rng(17);
+  vertex_index_vector labels(n_vertices);
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    labels[v] = static_cast<vertex_index>(v);
+  }
+  std::shuffle(labels.begin(), labels.end(), rng);
+  vertex_index_vector sources;
+  vertex_index_vector targets;
+  for (std::size_t v = 1; v < n_vertices; v++) {
+    std::uniform_int_distribution<std::size_t> dist(0, v - 1);
+    sources.push_back(labels[v]);
+    targets.push_back(labels[dist(rng)]);
+  }
+  csr_graph graph = csr_graph(n_vertices, sources, targets).symmetrize();
+  vertex_coloring natural = greedy_coloring(graph, coloring_order::natural);
+  ASSERT_TRUE(valid_coloring(graph, natural.colors));
+  vertex_coloring smallest_last = greedy_coloring(graph);
+  ASSERT_TRUE(valid_coloring(graph, smallest_last.colors));
+  ASSERT_EQ(2U, smallest_last.n_colors);
+}
+
+/**
+ * Test coloring orders and parallel coloring on a random graph.
+ */
+TEST(ColoringTest, RandomTest)
+{
+  std::size_t n_vertices = 2000;
+  std::mt19937 rng(31);
+  std::uniform_int_distribution<vertex_index> dist(0, n_vertices - 1);
+  vertex_index_vector sources(20000);
+  vertex_index_vector targets(sources.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    sources[i] = dist(rng);
+    targets[i] = dist(rng);
+  }
+  csr_graph graph = csr_graph(n_vertices, sources, targets).symmetrize();
+  std::size_t max_degree = 0;
+  for (vertex_index v = 0; v < n_vertices; v++) {
+    max_degree = std::max(max_degree, graph.degree(v));
+  }
+  for (
+    coloring_order order : {
+      coloring_order::natural,
+      coloring_order::largest_first,
+      coloring_order::smallest_last
+    }
+  ) {
+    vertex_index_vector sequence = coloring_sequence(graph, order);
+    ASSERT_EQ(n_vertices, sequence.size());
+    vertex_coloring coloring = greedy_coloring(graph, order);
+    ASSERT_TRUE(valid_coloring(graph, coloring.colors));
+    ASSERT_LE(coloring.n_colors, max_degree + 1);
+  }
+  vertex_index_vector largest_first = coloring_sequence(
+    graph, coloring_order::largest_first
+  );
+  // ordering ignores self-loops
+  auto loopless_degree = [&](vertex_index v)
+  {
+    return graph.degree(v) - graph.has_edge(v, v);
+  };
+  for (std::size_t i = 1; i < n_vertices; i++) {
+    ASSERT_GE(
+      loopless_degree(largest_first[i - 1]), loopless_degree(largest_first[i])
+    );
+  }
+  // degeneracy ordering uses at most one more color than the degeneracy
+  vertex_index_vector cores = core_numbers(graph);
+  ASSERT_LE(
+    greedy_coloring(graph).n_colors,
+    *std::max_element(cores.begin(), cores.end()) + 1U
+  );
+  for (std::size_t n_threads : {1, 4}) {
+    vertex_coloring coloring = parallel_coloring(graph, n_threads);
+    ASSERT_TRUE(valid_coloring(graph, coloring.colors));
+    ASSERT_LE(coloring.n_colors, max_degree + 1);
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
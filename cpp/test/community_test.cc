@@ -0,0 +1,135 @@
+/**
+ * @file community_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for community detection in community.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/community.h"
+
+#include <cstddef>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with dense cliques joined in a ring by single bridge edges.
+ */
+class CommunityTest : public ::testing::Test {
+protected:
+  /**
+   * Build `n_cliques_` cliques of `clique_size_` vertices each.
+   */
+  CommunityTest()
+  {
+    vertex_index_vector sources;
+    vertex_index_vector targets;
+    for (std::size_t c = 0; c < n_cliques_; c++) {
+      vertex_index first = static_cast<vertex_index>(c * clique_size_);
+      for (vertex_index u = 0; u < clique_size_; u++) {
+        for (vertex_index v = u + 1; v < clique_size_; v++) {
+          sources.push_back(first + u);
+          targets.push_back(first + v);
+        }
+      }
+      // bridge from the last vertex to the first vertex of the next clique
+      sources.push_back(first + clique_size_ - 1);
+      targets.push_back(
+        static_cast<vertex_index>(((c + 1) % n_cliques_) * clique_size_)
+      );
+    }
+    graph_ = csr_graph(n_cliques_ * clique_size_, sources, targets)
+      .symmetrize();
+  }
+
+  /**
+   * Check that communities are exactly the cliques.
+   *
+   * @param communities `const community_assignment&` detected communities
+   */
+  void check_cliques(const community_assignment& communities)
+  {
+    ASSERT_EQ(n_cliques_, communities.n_communities);
+    for (std::size_t v = 0; v < graph_.n_vertices(); v++) {
+      std::size_t first = v - v % clique_size_;
+      ASSERT_EQ(communities.labels[first], communities.labels[v]);
+      if (v >= clique_size_) {
+        ASSERT_NE(communities.labels[v - clique_size_], communities.labels[v]);
+      }
+    }
+  }
+
+  static constexpr std::size_t n_cliques_ = 6;
+  static constexpr vertex_index clique_size_ = 6;
+  csr_graph graph_;
+};
+
+/**
+ * Test that Louvain recovers the cliques and improves modularity.
+ */
+TEST_F(CommunityTest, LouvainTest)
+{
+  community_assignment communities = louvain(graph_);
+  check_cliques(communities);
+  // every clique keeps 30 of its 32 arc weight units inside
+  double inside = 30. / 32;
+  double expected = inside - 1. / n_cliques_;
+  ASSERT_NEAR(expected, modularity(graph_, communities.labels), 1e-12);
+  vertex_index_vector singletons(graph_.n_vertices());
+  for (std::size_t v = 0; v < singletons.size(); v++) {
+    singletons[v] = static_cast<vertex_index>(v);
+  }
+  ASSERT_GT(
+    modularity(graph_, communities.labels), modularity(graph_, singletons)
+  );
+}
+
+/**
+ * Test that label propagation recovers the cliques.
+ */
+TEST_F(CommunityTest, LabelPropagationTest)
+{
+  check_cliques(label_propagation(graph_, 100, 5, 1));
+  community_assignment communities = label_propagation(graph_, 100, 5, 4);
+  ASSERT_LE(communities.n_communities, n_cliques_ * clique_size_);
+  for (vertex_index label : communities.labels) {
+    ASSERT_LT(label, communities.n_communities);
+  }
+}
+
+/**
+ * Test that Louvain merges weakly weighted pairs on a weighted graph.
+ */
+TEST_F(CommunityTest, WeightedTest)
+{
+  // 0 = 1 and 2 = 3 are heavy, 1 - 2 is light
+  csr_graph graph = csr_graph(
+    4,
+    vertex_index_vector({0, 1, 2}),
+    vertex_index_vector({1, 2, 3}),
+    double_vector({10, 1, 10})
+  ).symmetrize();
+  community_assignment communities = louvain(graph);
+  ASSERT_EQ(2U, communities.n_communities);
+  ASSERT_EQ(vertex_index_vector({0, 0, 1, 1}), communities.labels);
+  communities = label_propagation(graph, 100, 1, 2);
+  ASSERT_EQ(2U, communities.n_communities);
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,190 @@
+/**
+ * @file compressed_graph_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the compressed graph representation
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/compressed_graph.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/dag.h"
+#include "pdcip/cpp/pagerank.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Breadth-first hop distances written once for any graph representation.
+ *
+ * @tparam graph_t graph type providing `n_vertices` and `for_each_neighbor`
+ * @param graph `const graph_t&` graph to search
+ * @param source `vertex_index` source vertex
+ */
+template <typename graph_t>
+vertex_index_vector bfs_distances(const graph_t& graph, vertex_index source)
+{
+  constexpr vertex_index unreached = std::numeric_limits<vertex_index>::max();
+  vertex_index_vector dists(graph.n_vertices(), unreached);
+  vertex_index_vector queue{source};
+  dists[source] = 0;
+  for (std::size_t i = 0; i < queue.size(); i++) {
+    vertex_index v = queue[i];
+    graph.for_each_neighbor(
+      v,
+      [&](vertex_index u, edge_index)
+      {
+        if (dists[u] == unreached) {
+          dists[u] = dists[v] + 1;
+          queue.push_back(u);
+        }
+      }
+    );
+  }
+  return dists;
+}
+
+/**
+ * Test that a random weighted graph survives compression exactly.
+ */
+TEST(CompressedGraphTest, RoundTripTest)
+{
+  std::size_t n_vertices = 1000;
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<vertex_index> dist(0, n_vertices - 1);
+  std::uniform_real_distribution<double> weight_dist(0, 1);
+  vertex_index_vector sources(8000);
+  vertex_index_vector targets(sources.size());
+  double_vector weights(sources.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    sources[i] = dist(rng);
+    // include the largest index to exercise multi-byte deltas
+    targets[i] = (i % 100) ? dist(rng) : vertex_index(n_vertices - 1);
+    weights[i] = weight_dist(rng);
+  }
+  csr_graph graph(n_vertices, sources, targets, weights);
+  compressed_graph compressed(graph, 3);
+  ASSERT_EQ(graph.n_vertices(), compressed.n_vertices());
+  ASSERT_EQ(graph.n_edges(), compressed.n_edges());
+  ASSERT_TRUE(compressed.weighted());
+  for (vertex_index v = 0; v < n_vertices; v++) {
+    ASSERT_EQ(graph.degree(v), compressed.degree(v));
+    ASSERT_EQ(graph.edges_begin(v), compressed.edges_begin(v));
+    ASSERT_EQ(graph.edges_end(v), compressed.edges_end(v));
+    ASSERT_EQ(
+      vertex_index_vector(graph.neighbors_begin(v), graph.neighbors_end(v)),
+      compressed.neighbors(v)
+    );
+    compressed.for_each_neighbor(
+      v,
+      [&](vertex_index u, edge_index e)
+      {
+        ASSERT_EQ(graph.target(e), u);
+        ASSERT_EQ(graph.weight(e), compressed.weight(e));
+      }
+    );
+    for (vertex_index u = 0; u < n_vertices; u += 7) {
+      ASSERT_EQ(graph.has_edge(v, u), compressed.has_edge(v, u));
+    }
+  }
+  ASSERT_EQ(bfs_distances(graph, 0), bfs_distances(compressed, 0));
+  csr_graph decompressed = compressed.decompress(2);
+  ASSERT_EQ(
+    vertex_index_vector(graph.targets(), graph.targets() + graph.n_edges()),
+    vertex_index_vector(
+      decompressed.targets(), decompressed.targets() + decompressed.n_edges()
+    )
+  );
+}
+
+/**
+ * Test that a graph with local edges takes about one byte per edge.
+ */
+TEST(CompressedGraphTest, LocalityTest)
+{
+  std::size_t n_vertices = 5000;
+  vertex_index_vector sources;
+  vertex_index_vector targets;
+  // ring lattice where each vertex links to the 4 vertices on either side
+  for (std::size_t v = 0; v < n_vertices; v++) {
+    for (std::size_t k = 1; k <= 4; k++) {
+      sources.push_back(static_cast<vertex_index>(v));
+      targets.push_back(static_cast<vertex_index>((v + k) % n_vertices));
+    }
+  }
+  csr_graph graph = csr_graph(n_vertices, sources, targets).symmetrize();
+  compressed_graph compressed(graph);
+  ASSERT_FALSE(compressed.weighted());
+  ASSERT_EQ(graph.n_edges(), compressed.n_edges());
+  // one byte per edge and per degree, a byte offset per vertex, a sampled
+  // edge index per interval, and a few multi-byte wraparound first deltas
+  std::size_t n_samples =
+    n_vertices / compressed_graph::edge_sample_interval + 1;
+  ASSERT_LE(
+    compressed.n_bytes(),
+    graph.n_edges() + n_vertices * (1 + sizeof(edge_index)) +
+      n_samples * sizeof(edge_index) + 32
+  );
+  ASSERT_EQ(bfs_distances(graph, 17), bfs_distances(compressed, 17));
+}
+
+/**
+ * Test that traversals give the same results on both representations.
+ */
+TEST(CompressedGraphTest, TraversalTest)
+{
+  std::size_t n_vertices = 1500;
+  std::mt19937 rng(63);
+  std::uniform_int_distribution<vertex_index> dist(0, n_vertices - 1);
+  vertex_index_vector sources(12000);
+  vertex_index_vector targets(sources.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    // edges only go up so the graph is acyclic with several levels
+    vertex_index u = dist(rng);
+    vertex_index v = dist(rng);
+    sources[i] = std::min(u, v);
+    targets[i] = (u == v) ? vertex_index(n_vertices - 1) : std::max(u, v);
+  }
+  csr_graph graph(n_vertices, sources, targets);
+  compressed_graph compressed(graph);
+  ASSERT_EQ(graph.in_degrees(), compressed.in_degrees());
+  csr_graph reverse = graph.transpose();
+  csr_graph compressed_reverse = compressed.transpose();
+  ASSERT_EQ(
+    vertex_index_vector(reverse.targets(), reverse.targets() + graph.n_edges()),
+    vertex_index_vector(
+      compressed_reverse.targets(),
+      compressed_reverse.targets() + compressed_reverse.n_edges()
+    )
+  );
+  topological_levels levels = topological_sort(graph);
+  topological_levels compressed_levels = topological_sort(compressed);
+  ASSERT_TRUE(compressed_levels.acyclic());
+  ASSERT_EQ(levels.order, compressed_levels.order);
+  ASSERT_EQ(levels.level_offsets, compressed_levels.level_offsets);
+  double_vector ranks;
+  double_vector compressed_ranks;
+  pagerank(graph).solve(ranks);
+  pagerank(compressed).solve(compressed_ranks);
+  ASSERT_EQ(ranks, compressed_ranks);
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,136 @@
+/**
+ * @file csr_graph_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the CSR graph representation in csr_graph.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/csr_graph.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a small weighted directed graph in CSR form.
+ */
+class CsrGraphTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the graph from unsorted edge arrays.
+   *
+   * The graph has edges 0 -> {1, 2}, 1 -> {2}, 2 -> {0, 3}.
+   */
+  CsrGraphTest()
+    : graph_(
+        n_vertices_,
+        vertex_index_vector({2, 0, 1, 2, 0}),
+        vertex_index_vector({3, 2, 2, 0, 1}),
+        double_vector({4, 2, 3, 5, 1})
+      )
+  {}
+
+  const csr_graph graph_;
+  static const std::size_t n_vertices_;
+};
+
+const std::size_t CsrGraphTest::n_vertices_ = 4;
+
+/**
+ * Test that rows are grouped by source and sorted by target.
+ */
+TEST_F(CsrGraphTest, LayoutTest)
+{
+  ASSERT_EQ(n_vertices_, graph_.n_vertices());
+  ASSERT_EQ(5, graph_.n_edges());
+  ASSERT_TRUE(graph_.weighted());
+  ASSERT_EQ(
+    edge_index_vector({0, 2, 3, 5, 5}),
+    edge_index_vector(graph_.offsets(), graph_.offsets() + n_vertices_ + 1)
+  );
+  ASSERT_EQ(
+    vertex_index_vector({1, 2, 2, 0, 3}),
+    vertex_index_vector(graph_.targets(), graph_.targets() + 5)
+  );
+  ASSERT_EQ(
+    double_vector({1, 2, 3, 5, 4}),
+    double_vector(graph_.weights(), graph_.weights() + 5)
+  );
+  ASSERT_TRUE(graph_.has_edge(2, 3));
+  ASSERT_FALSE(graph_.has_edge(3, 2));
+  ASSERT_TRUE(std::isnan(graph_.value(0)));
+}
+
+/**
+ * Test that the transpose reverses every edge.
+ */
+TEST_F(CsrGraphTest, TransposeTest)
+{
+  csr_graph reversed = graph_.transpose();
+  ASSERT_EQ(graph_.n_edges(), reversed.n_edges());
+  ASSERT_EQ(edge_index_vector({1, 1, 2, 1}), graph_.in_degrees());
+  for (vertex_index v = 0; v < n_vertices_; v++) {
+    ASSERT_EQ(graph_.in_degrees()[v], reversed.degree(v));
+    graph_.for_each_neighbor(
+      v,
+      [&](vertex_index u, edge_index) { ASSERT_TRUE(reversed.has_edge(u, v)); }
+    );
+  }
+}
+
+/**
+ * Test that symmetrizing merges antiparallel edges, keeping the min weight.
+ */
+TEST_F(CsrGraphTest, SymmetrizeTest)
+{
+  csr_graph undirected = graph_.symmetrize();
+  // 0 <-> 2 appears in both directions, so 8 directed edges remain
+  ASSERT_EQ(8, undirected.n_edges());
+  ASSERT_EQ(
+    vertex_index_vector({1, 2}),
+    vertex_index_vector(
+      undirected.neighbors_begin(0), undirected.neighbors_end(0)
+    )
+  );
+  ASSERT_DOUBLE_EQ(2, undirected.weight(undirected.edges_begin(0) + 1));
+  ASSERT_DOUBLE_EQ(2, undirected.weight(undirected.edges_begin(2)));
+}
+
+/**
+ * Test that a `csr_graph` can be built from `vertex` and `edge` pointers.
+ */
+TEST(CsrGraphConvertTest, FromPointersTest)
+{
+  vertex_ptr_vector vertices = {
+    std::make_shared<vertex>(1), std::make_shared<vertex>(2)
+  };
+  edge_ptr_vector edges = {
+    std::make_shared<edge>(vertices[1], vertices[0], 7)
+  };
+  csr_graph graph(vertices, edges);
+  ASSERT_EQ(2, graph.n_vertices());
+  ASSERT_EQ(1, graph.n_edges());
+  ASSERT_TRUE(graph.has_edge(1, 0));
+  ASSERT_DOUBLE_EQ(7, graph.weight(0));
+  ASSERT_DOUBLE_EQ(2, graph.value(1));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,124 @@
+/**
+ * @file dag_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for topological sorting and DAG scheduling in dag.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/dag.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a small diamond-shaped DAG.
+ */
+class DagTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the DAG.
+   *
+   * The DAG has edges 0 -> {1, 2}, {1, 2} -> 3, 3 -> 5, and an isolated 4.
+   */
+  DagTest()
+    : dag_(
+        6,
+        vertex_index_vector({0, 0, 1, 2, 3}),
+        vertex_index_vector({1, 2, 3, 3, 5})
+      )
+  {}
+
+  /**
+   * Check that each vertex comes after all of its dependencies.
+   *
+   * @param finished `const std::vector<std::size_t>&` giving the position at
+   *    which each vertex was finished
+   */
+  void check_dependencies(const std::vector<std::size_t>& finished) const
+  {
+    for (vertex_index v = 0; v < dag_.n_vertices(); v++) {
+      dag_.for_each_neighbor(
+        v,
+        [&](vertex_index next, edge_index)
+        {
+          EXPECT_LT(finished[v], finished[next]);
+        }
+      );
+    }
+  }
+
+  const csr_graph dag_;
+};
+
+/**
+ * Test that Kahn's algorithm gives the expected levels.
+ */
+TEST_F(DagTest, LevelsTest)
+{
+  topological_levels levels = topological_sort(dag_);
+  ASSERT_TRUE(levels.acyclic());
+  ASSERT_EQ(4, levels.n_levels());
+  ASSERT_EQ(vertex_index_vector({0, 4, 1, 2, 3, 5}), levels.order);
+  ASSERT_EQ(edge_index_vector({0, 2, 4, 5, 6}), levels.level_offsets);
+}
+
+/**
+ * Test that cycles are detected.
+ */
+TEST_F(DagTest, CycleTest)
+{
+  csr_graph cyclic(
+    3, vertex_index_vector({0, 1, 2}), vertex_index_vector({1, 2, 1})
+  );
+  topological_levels levels = topological_sort(cyclic);
+  ASSERT_FALSE(levels.acyclic());
+  ASSERT_EQ(vertex_index_vector({0}), levels.order);
+  ASSERT_EQ(
+    1, dag_schedule(cyclic, [](vertex_index) {}, dag_schedule_type::level_sync)
+  );
+  ASSERT_EQ(1, dag_schedule(cyclic, [](vertex_index) {}));
+}
+
+/**
+ * Test that both schedules run every task after its dependencies.
+ */
+TEST_F(DagTest, ScheduleTest)
+{
+  for (
+    dag_schedule_type schedule :
+    {dag_schedule_type::level_sync, dag_schedule_type::dependency_count}
+  ) {
+    std::atomic<std::size_t> counter(0);
+    std::vector<std::size_t> finished(dag_.n_vertices());
+    std::size_t n_run = dag_schedule(
+      dag_,
+      [&](vertex_index v) { finished[v] = counter.fetch_add(1); },
+      schedule,
+      4
+    );
+    ASSERT_EQ(dag_.n_vertices(), n_run);
+    check_dependencies(finished);
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,118 @@
+/**
+ * @file dynamic_graph_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the mutable graph in dynamic_graph.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/dynamic_graph.h"
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test single small batches, including duplicates and weight overwrites.
+ */
+TEST(DynamicGraphTest, BatchTest)
+{
+  dynamic_graph graph(2, true);
+  ASSERT_EQ(
+    3U,
+    graph.insert_edges(
+      {0, 0, 3, 0}, {2, 1, 0, 2}, {1.5, 2.5, 3.5, 4.5}
+    )
+  );
+  // vertex 3 was added to fit the batch
+  ASSERT_EQ(4U, graph.n_vertices());
+  ASSERT_EQ(3U, graph.n_edges());
+  // last duplicate in the batch wins
+  ASSERT_EQ(4.5, graph.weight(0, 2));
+  ASSERT_TRUE(std::isnan(graph.weight(1, 0)));
+  // existing edge gets its weight overwritten, new one is merged in order
+  ASSERT_EQ(1U, graph.insert_edges({0, 0}, {2, 0}, {-1, 7}));
+  ASSERT_EQ(-1, graph.weight(0, 2));
+  vertex_index_vector targets;
+  graph.for_each_neighbor(
+    0, [&](vertex_index u, double) { targets.push_back(u); }
+  );
+  ASSERT_EQ(vertex_index_vector({0, 1, 2}), targets);
+  ASSERT_EQ(2U, graph.remove_edges({0, 0, 2, 3}, {1, 3, 2, 0}));
+  ASSERT_EQ(2U, graph.n_edges());
+  ASSERT_FALSE(graph.has_edge(3, 0));
+  csr_graph compact = graph.to_csr();
+  ASSERT_EQ(2U, compact.n_edges());
+  ASSERT_TRUE(compact.has_edge(0, 0));
+  ASSERT_TRUE(compact.has_edge(0, 2));
+  ASSERT_EQ(-1, compact.weight(1));
+}
+
+/**
+ * Test random parallel batches against a reference edge map.
+ */
+TEST(DynamicGraphTest, RandomTest)
+{
+  std::size_t n_vertices = 300;
+  std::mt19937 rng(19);
+  std::uniform_int_distribution<vertex_index> dist(0, n_vertices - 1);
+  std::uniform_real_distribution<double> weight_dist(0, 1);
+  dynamic_graph graph(n_vertices, true);
+  std::map<std::pair<vertex_index, vertex_index>, double> expected;
+  for (std::size_t round = 0; round < 20; round++) {
+    vertex_index_vector sources(1000);
+    vertex_index_vector targets(sources.size());
+    double_vector weights(sources.size());
+    for (std::size_t i = 0; i < sources.size(); i++) {
+      sources[i] = dist(rng);
+      targets[i] = dist(rng);
+      weights[i] = weight_dist(rng);
+      expected[{sources[i], targets[i]}] = weights[i];
+    }
+    graph.insert_edges(sources, targets, weights, 4);
+    for (std::size_t i = 0; i < 400; i++) {
+      sources[i] = dist(rng);
+      targets[i] = dist(rng);
+      expected.erase({sources[i], targets[i]});
+    }
+    sources.resize(400);
+    targets.resize(400);
+    graph.remove_edges(sources, targets, 3);
+    ASSERT_EQ(expected.size(), graph.n_edges());
+  }
+  csr_graph compact = graph.to_csr(2);
+  ASSERT_EQ(expected.size(), compact.n_edges());
+  edge_index e = 0;
+  // std::map iterates in the same (source, target) order as CSR rows
+  for (const auto& [edge, weight] : expected) {
+    ASSERT_EQ(edge.second, compact.target(e));
+    ASSERT_EQ(weight, compact.weight(e));
+    ASSERT_TRUE(compact.has_edge(edge.first, edge.second));
+    e++;
+  }
+  // round trip through the csr_graph constructor
+  dynamic_graph copy(compact);
+  ASSERT_EQ(graph.n_edges(), copy.n_edges());
+  ASSERT_EQ(graph.degree(7), copy.degree(7));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,107 @@
+/**
+ * @file fenwick_tree_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the Fenwick (binary indexed) tree
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/fenwick_tree.h"
+
+#include <cstddef>
+#include <numeric>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with random integer-valued data, so sums are exact.
+ */
+class FenwickTreeTest : public ::testing::Test {
+protected:
+  FenwickTreeTest() : rng_(71), values_(n_values_)
+  {
+    for (double& value : values_) {
+      value = static_cast<double>(rng_() % 100);
+    }
+  }
+
+  /**
+   * Check every range sum starting at a position against a plain array.
+   *
+   * @param tree `const fenwick_tree&` tree over `values_`
+   * @param begin `std::size_t` first position of the ranges
+   */
+  void check_sums(const fenwick_tree& tree, std::size_t begin) const
+  {
+    double expected = 0;
+    for (std::size_t end = begin; end <= n_values_; end++) {
+      ASSERT_EQ(expected, tree.sum(begin, end));
+      if (end < n_values_) {
+        expected += values_[end];
+      }
+    }
+  }
+
+  static constexpr std::size_t n_values_ = 200;
+  std::mt19937_64 rng_;
+  double_vector values_;
+};
+
+/**
+ * Test that construction gives the right prefix and range sums.
+ */
+TEST_F(FenwickTreeTest, BuildTest)
+{
+  fenwick_tree tree(values_);
+  ASSERT_EQ(n_values_, tree.size());
+  ASSERT_EQ(
+    std::accumulate(values_.begin(), values_.end(), 0.),
+    tree.prefix_sum(n_values_)
+  );
+  ASSERT_EQ(0, tree.prefix_sum(0));
+  for (std::size_t begin = 0; begin < n_values_; begin += 13) {
+    check_sums(tree, begin);
+  }
+  ASSERT_EQ(0, fenwick_tree().size());
+}
+
+/**
+ * Test point updates against a plain array.
+ */
+TEST_F(FenwickTreeTest, UpdateTest)
+{
+  fenwick_tree tree(values_);
+  for (std::size_t i = 0; i < 500; i++) {
+    std::size_t pos = rng_() % n_values_;
+    auto amount = static_cast<double>(rng_() % 100) - 50;
+    if (i % 2) {
+      tree.add(pos, amount);
+      values_[pos] += amount;
+    }
+    else {
+      tree.set(pos, amount);
+      values_[pos] = amount;
+    }
+    ASSERT_EQ(values_[pos], tree.value(pos));
+  }
+  for (std::size_t begin = 0; begin < n_values_; begin += 7) {
+    check_sums(tree, begin);
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
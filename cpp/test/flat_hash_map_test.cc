@@ -0,0 +1,171 @@
+/**
+ * @file flat_hash_map_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the flat open-addressing hash map
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/flat_hash_map.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Return the inverse of an odd 64-bit multiplier modulo `2^64`.
+ *
+ * Each Newton step doubles the number of correct low bits, starting from 3.
+ *
+ * @param factor `std::uint64_t` odd multiplier
+ */
+std::uint64_t inverse_multiplier(std::uint64_t factor)
+{
+  std::uint64_t inverse = factor;
+  for (int i = 0; i < 5; i++) {
+    inverse *= 2 - factor * inverse;
+  }
+  return inverse;
+}
+
+/**
+ * Return the inverse of `x ^= x >> shift`.
+ *
+ * @param x `std::uint64_t` value to unshift
+ * @param shift `unsigned int` shift used by the xorshift
+ */
+std::uint64_t unxorshift(std::uint64_t x, unsigned int shift)
+{
+  std::uint64_t result = x;
+  for (unsigned int done = shift; done < 64; done += shift) {
+    result = x ^ (result >> shift);
+  }
+  return result;
+}
+
+/**
+ * Return the key that `mix_hash` maps to a given hash.
+ *
+ * @param hash `std::uint64_t` hash to invert
+ */
+std::uint64_t unmix_hash(std::uint64_t hash)
+{
+  hash = unxorshift(hash, 31);
+  hash *= inverse_multiplier(0x94d049bb133111ebULL);
+  hash = unxorshift(hash, 27);
+  hash *= inverse_multiplier(0xbf58476d1ce4e5b9ULL);
+  return unxorshift(hash, 30);
+}
+
+/**
+ * Test fixture for `flat_hash_map` tests.
+ */
+class FlatHashMapTest : public ::testing::Test {
+protected:
+  flat_hash_map<int> map_;
+};
+
+/**
+ * Test that insertion, lookup, and erasure work on a few keys.
+ */
+TEST_F(FlatHashMapTest, BasicTest)
+{
+  ASSERT_TRUE(map_.empty());
+  ASSERT_EQ(nullptr, map_.find(7));
+  ASSERT_FALSE(map_.erase(7));
+  ASSERT_TRUE(map_.emplace(7).second);
+  map_.emplace(7).first = 3;
+  ASSERT_FALSE(map_.emplace(7).second);
+  ASSERT_EQ(1, map_.size());
+  ASSERT_NE(nullptr, map_.find(7));
+  ASSERT_EQ(3, *map_.find(7));
+  ASSERT_FALSE(map_.contains(8));
+  ASSERT_TRUE(map_.erase(7));
+  ASSERT_FALSE(map_.contains(7));
+  ASSERT_TRUE(map_.empty());
+}
+
+/**
+ * Test random insertions and erasures against `std::unordered_map`.
+ *
+ * Keys are drawn from a small range so that erasure and reinsertion of the
+ * same key, and the backward shifts they cause, happen often.
+ */
+TEST_F(FlatHashMapTest, RandomOperationsTest)
+{
+  std::unordered_map<std::uint64_t, int> expected;
+  std::mt19937_64 rng(8);
+  std::uniform_int_distribution<std::uint64_t> keys(0, 4000);
+  for (int i = 0; i < 50000; i++) {
+    // keys near multiples of 2^32 mimic packed vertex index pairs
+    std::uint64_t key = keys(rng) << ((i % 2) ? 32 : 0);
+    if (rng() % 3) {
+      map_.emplace(key).first = i;
+      expected[key] = i;
+    }
+    else {
+      ASSERT_EQ(expected.erase(key) > 0, map_.erase(key));
+    }
+  }
+  ASSERT_EQ(expected.size(), map_.size());
+  ASSERT_LE(8 * map_.size(), 7 * map_.capacity());
+  for (const auto& [key, value] : expected) {
+    ASSERT_NE(nullptr, map_.find(key));
+    ASSERT_EQ(value, *map_.find(key));
+  }
+  std::size_t n_visited = 0;
+  map_.for_each(
+    [&](std::uint64_t key, int value)
+    {
+      ASSERT_EQ(expected.at(key), value);
+      n_visited++;
+    }
+  );
+  ASSERT_EQ(expected.size(), n_visited);
+  map_.clear();
+  ASSERT_TRUE(map_.empty());
+  ASSERT_FALSE(map_.contains(expected.begin()->first));
+}
+
+/**
+ * Test that a probe cluster too long for the stored distance grows the table.
+ *
+ * The keys all hash to multiples of `2^12`, so they share one home slot
+ * until the table has more than `2^12` slots.
+ */
+TEST_F(FlatHashMapTest, LongClusterTest)
+{
+  std::size_t n_keys = 600;
+  for (std::uint64_t j = 1; j <= n_keys; j++) {
+    std::uint64_t key = unmix_hash(j << 12);
+    ASSERT_EQ(j << 12, mix_hash(key));
+    auto slot = map_.emplace(key);
+    ASSERT_TRUE(slot.second);
+    slot.first = static_cast<int>(j);
+  }
+  ASSERT_EQ(n_keys, map_.size());
+  ASSERT_LT(4096U, map_.capacity());
+  for (std::uint64_t j = 1; j <= n_keys; j++) {
+    const int* value = map_.find(unmix_hash(j << 12));
+    ASSERT_TRUE(value);
+    ASSERT_EQ(static_cast<int>(j), *value);
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
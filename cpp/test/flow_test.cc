@@ -0,0 +1,135 @@
+/**
+ * @file flow_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the maximum flow algorithms in flow.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/flow.h"
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Check that a flow respects capacities and conservation.
+ *
+ * @param graph `const csr_graph&` graph the flow is on
+ * @param result `const flow_result&` flow to check
+ * @param source `vertex_index` flow source
+ * @param sink `vertex_index` flow sink
+ */
+void check_flow(
+  const csr_graph& graph,
+  const flow_result& result,
+  vertex_index source,
+  vertex_index sink)
+{
+  double_vector balance(graph.n_vertices(), 0);
+  vertex_index_vector sources = graph.edge_sources();
+  for (edge_index e = 0; e < graph.n_edges(); e++) {
+    ASSERT_GE(result.edge_flows[e], 0);
+    ASSERT_LE(result.edge_flows[e], graph.weight(e));
+    balance[sources[e]] -= result.edge_flows[e];
+    balance[graph.target(e)] += result.edge_flows[e];
+  }
+  for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+    if (v != source && v != sink) {
+      ASSERT_NEAR(0, balance[v], 1e-9);
+    }
+  }
+  ASSERT_NEAR(result.value, balance[sink], 1e-9);
+  ASSERT_TRUE(result.source_side[source]);
+  ASSERT_FALSE(result.source_side[sink]);
+  for (edge_index e : result.cut_edges) {
+    ASSERT_DOUBLE_EQ(graph.weight(e), result.edge_flows[e]);
+  }
+}
+
+/**
+ * Test fixture with the classic six-vertex flow network.
+ */
+class FlowTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the network from Cormen et al. with max flow 23.
+   */
+  FlowTest()
+    : graph_(
+        6,
+        vertex_index_vector({0, 0, 1, 2, 1, 3, 2, 4, 3, 4}),
+        vertex_index_vector({1, 2, 3, 1, 2, 2, 4, 3, 5, 5}),
+        double_vector({16, 13, 12, 4, 10, 9, 14, 7, 20, 4})
+      )
+  {}
+
+  const csr_graph graph_;
+};
+
+/**
+ * Test that push-relabel finds the maximum flow.
+ */
+TEST_F(FlowTest, PushRelabelTest)
+{
+  flow_result result = push_relabel_max_flow(graph_, 0, 5);
+  ASSERT_DOUBLE_EQ(23, result.value);
+  check_flow(graph_, result, 0, 5);
+}
+
+/**
+ * Test that Dinic's algorithm finds the maximum flow.
+ */
+TEST_F(FlowTest, DinicTest)
+{
+  flow_result result = dinic_max_flow(graph_, 0, 5);
+  ASSERT_DOUBLE_EQ(23, result.value);
+  check_flow(graph_, result, 0, 5);
+}
+
+/**
+ * Test that both algorithms agree on random networks.
+ */
+TEST(FlowRandomTest, AgreementTest)
+{
+  std::mt19937 rng(13);
+  for (std::size_t trial = 0; trial < 20; trial++) {
+    std::size_t n_vertices = 50;
+    std::uniform_int_distribution<vertex_index> vert_dist(0, n_vertices - 1);
+    std::uniform_int_distribution<int> cap_dist(0, 9);
+    vertex_index_vector sources(300);
+    vertex_index_vector targets(sources.size());
+    double_vector caps(sources.size());
+    for (std::size_t i = 0; i < sources.size(); i++) {
+      sources[i] = vert_dist(rng);
+      targets[i] = vert_dist(rng);
+      // odd trials are unit-capacity networks
+      caps[i] = (trial % 2) ? 1 : cap_dist(rng);
+    }
+    csr_graph graph(n_vertices, sources, targets, caps);
+    flow_result push_relabel = push_relabel_max_flow(graph, 0, 1);
+    flow_result dinic = dinic_max_flow(graph, 0, 1);
+    ASSERT_DOUBLE_EQ(push_relabel.value, dinic.value);
+    check_flow(graph, push_relabel, 0, 1);
+    check_flow(graph, dinic, 0, 1);
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
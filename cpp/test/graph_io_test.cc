@@ -0,0 +1,198 @@
+/**
+ * @file graph_io_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for graph loaders in graph_io.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/graph_io.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Check that a graph has the given out-neighbors and weights.
+ *
+ * @param graph `const csr_graph&` graph to check
+ * @param vert `vertex_index` vertex whose row is checked
+ * @param targets `const vertex_index_vector&` expected sorted targets
+ * @param weights `const double_vector&` expected weights
+ */
+void check_row(
+  const csr_graph& graph,
+  vertex_index vert,
+  const vertex_index_vector& targets,
+  const double_vector& weights)
+{
+  ASSERT_EQ(
+    targets,
+    vertex_index_vector(graph.neighbors_begin(vert), graph.neighbors_end(vert))
+  );
+  for (std::size_t i = 0; i < targets.size(); i++) {
+    ASSERT_DOUBLE_EQ(weights[i], graph.weight(graph.edges_begin(vert) + i));
+  }
+}
+
+/**
+ * Test parsing a small edge list with comments and mixed weights.
+ */
+TEST(GraphIOTest, EdgeListTest)
+{
+  std::string text =
+    "# comment\n"
+    "0 1 2.5\n"
+    "\n"
+    "0\t2\r\n"
+    "  3 0 -1e-2\n"
+    "% another comment\n"
+    "2 3 1.25E+2";
+  std::optional<csr_graph> graph = parse_edge_list(text.data(), text.size());
+  ASSERT_TRUE(graph);
+  ASSERT_EQ(4U, graph->n_vertices());
+  ASSERT_EQ(4U, graph->n_edges());
+  ASSERT_TRUE(graph->weighted());
+  check_row(*graph, 0, {1, 2}, {2.5, 1});
+  check_row(*graph, 2, {3}, {125});
+  check_row(*graph, 3, {0}, {-0.01});
+  // unweighted when no line has a weight
+  text = "0 1\n1 2\n";
+  graph = parse_edge_list(text.data(), text.size());
+  ASSERT_TRUE(graph);
+  ASSERT_FALSE(graph->weighted());
+  // malformed lines
+  for (std::string bad : {"0 1 2 3\n", "0 x\n", "01\n", "0 1 1.5z\n"}) {
+    ASSERT_FALSE(parse_edge_list(bad.data(), bad.size())) << bad;
+  }
+}
+
+/**
+ * Test that chunked parsing across threads matches single-threaded parsing.
+ */
+TEST(GraphIOTest, ChunkedTest)
+{
+  std::mt19937 rng(41);
+  std::uniform_int_distribution<vertex_index> dist(0, 499);
+  std::uniform_real_distribution<double> weight_dist(-100, 100);
+  std::string text;
+  for (std::size_t i = 0; i < 5000; i++) {
+    text += std::to_string(dist(rng)) + " " + std::to_string(dist(rng)) + " ";
+    text += std::to_string(weight_dist(rng)) + "\n";
+  }
+  std::optional<csr_graph> expected = parse_edge_list(
+    text.data(), text.size(), 1
+  );
+  std::optional<csr_graph> actual = parse_edge_list(
+    text.data(), text.size(), 7
+  );
+  ASSERT_TRUE(expected && actual);
+  ASSERT_EQ(expected->n_edges(), actual->n_edges());
+  for (vertex_index v = 0; v < expected->n_vertices(); v++) {
+    ASSERT_EQ(expected->edges_begin(v), actual->edges_begin(v));
+    edge_index end = expected->edges_end(v);
+    for (edge_index e = expected->edges_begin(v); e < end; e++) {
+      ASSERT_EQ(expected->target(e), actual->target(e));
+      ASSERT_EQ(expected->weight(e), actual->weight(e));
+    }
+  }
+}
+
+/**
+ * Test parsing Matrix Market files of each supported kind.
+ */
+TEST(GraphIOTest, MatrixMarketTest)
+{
+  std::string text =
+    "%%MatrixMarket matrix coordinate real symmetric\n"
+    "% comment\n"
+    "3 3 3\n"
+    "1 1 4\n"
+    "2 1 -1.5\n"
+    "3 2 2\n";
+  std::optional<csr_graph> graph = parse_matrix_market(
+    text.data(), text.size(), 2
+  );
+  ASSERT_TRUE(graph);
+  ASSERT_EQ(3U, graph->n_vertices());
+  ASSERT_EQ(5U, graph->n_edges());
+  check_row(*graph, 0, {0, 1}, {4, -1.5});
+  check_row(*graph, 1, {0, 2}, {-1.5, 2});
+  text =
+    "%%MatrixMarket matrix coordinate pattern general\n"
+    "2 4 2\n"
+    "1 4\n"
+    "2 3\n";
+  graph = parse_matrix_market(text.data(), text.size());
+  ASSERT_TRUE(graph);
+  ASSERT_EQ(4U, graph->n_vertices());
+  ASSERT_FALSE(graph->weighted());
+  ASSERT_TRUE(graph->has_edge(0, 3));
+  ASSERT_TRUE(graph->has_edge(1, 2));
+  text =
+    "%%MatrixMarket matrix coordinate integer skew-symmetric\n"
+    "2 2 1\n"
+    "2 1 3\n";
+  graph = parse_matrix_market(text.data(), text.size());
+  ASSERT_TRUE(graph);
+  check_row(*graph, 0, {1}, {-3});
+  check_row(*graph, 1, {0}, {3});
+  // wrong entry count, out of range index, unsupported field
+  for (
+    std::string bad : {
+      "%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n",
+      "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n",
+      "%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 0\n"
+    }
+  ) {
+    ASSERT_FALSE(parse_matrix_market(bad.data(), bad.size())) << bad;
+  }
+}
+
+/**
+ * Test loading graphs from files through memory mapping.
+ */
+TEST(GraphIOTest, ReadFileTest)
+{
+  std::filesystem::path path = std::filesystem::temp_directory_path() /
+    "pdcip_graph_io_test.txt";
+  {
+    std::ofstream out(path);
+    out << "0 1\n1 2\n2 0\n";
+  }
+  std::optional<csr_graph> graph = read_edge_list(path.string());
+  ASSERT_TRUE(graph);
+  ASSERT_EQ(3U, graph->n_edges());
+  ASSERT_TRUE(graph->has_edge(2, 0));
+  {
+    std::ofstream out(path);
+    out << "%%MatrixMarket matrix coordinate pattern general\n1 1 1\n1 1\n";
+  }
+  graph = read_matrix_market(path.string());
+  ASSERT_TRUE(graph);
+  ASSERT_TRUE(graph->has_edge(0, 0));
+  std::filesystem::remove(path);
+  ASSERT_FALSE(read_edge_list(path.string()));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -92,6 +92,125 @@ TEST_F(EdgeTest, EqualsNotEqualsTest)
   ASSERT_EQ(*edge_, *other_edge_);
 }
 
+
+/**
+ * Test fixture for `graph` tests, with a directed triangle plus a loop.
+ */
+class GraphTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor setting up the `vertex` instances and `edge` instances.
+   */
+  GraphTest()
+    : verts_{
+        std::make_shared<vertex>(1),
+        std::make_shared<vertex>(2),
+        std::make_shared<vertex>(3)
+      },
+      edges_{
+        std::make_shared<edge>(verts_[0], verts_[1], 1),
+        std::make_shared<edge>(verts_[1], verts_[2], 2),
+        std::make_shared<edge>(verts_[2], verts_[0], 3),
+        std::make_shared<edge>(verts_[2], verts_[2], 4)
+      },
+      graph_(verts_, edges_)
+  {}
+
+  const vertex_ptr_vector verts_;
+  const edge_ptr_vector edges_;
+  graph graph_;
+};
+
+/**
+ * Test that the `graph` holds the vertices and edges it was built from.
+ */
+TEST_F(GraphTest, MembershipTest)
+{
+  ASSERT_EQ(verts_.size(), graph_.n_vertices());
+  ASSERT_EQ(edges_.size(), graph_.n_edges());
+  ASSERT_EQ(verts_, *graph_.vertices());
+  ASSERT_EQ(edges_, *graph_.edges());
+  for (const vertex_ptr& vert : verts_) {
+    ASSERT_TRUE(graph_.has_vertex(vert));
+  }
+  ASSERT_FALSE(graph_.has_vertex(std::make_shared<vertex>(1)));
+  for (const edge_ptr& arc : edges_) {
+    ASSERT_TRUE(graph_.has_edge(arc));
+    // equal edges are found even if they are distinct objects
+    ASSERT_TRUE(graph_.has_edge(edge(arc->start(), arc->end(), arc->weight())));
+  }
+  ASSERT_FALSE(graph_.has_edge(edge(verts_[0], verts_[1], 5)));
+  ASSERT_FALSE(graph_.has_edge(edge(verts_[1], verts_[0], 1)));
+}
+
+/**
+ * Test that `graph::connects` ignores weights and honors direction.
+ */
+TEST_F(GraphTest, ConnectsTest)
+{
+  ASSERT_TRUE(graph_.connects(verts_[0], verts_[1], false));
+  ASSERT_FALSE(graph_.connects(verts_[1], verts_[0], false));
+  ASSERT_TRUE(graph_.connects(verts_[1], verts_[0]));
+  ASSERT_TRUE(graph_.connects(verts_[2], verts_[2], false));
+  ASSERT_FALSE(graph_.connects(verts_[0], verts_[0]));
+  ASSERT_FALSE(graph_.connects(verts_[0], std::make_shared<vertex>(2)));
+}
+
+/**
+ * Test that duplicate edges are skipped and parallel edges are kept.
+ */
+TEST_F(GraphTest, AddEdgeTest)
+{
+  graph_.add_edge(std::make_shared<edge>(verts_[0], verts_[1], 1));
+  ASSERT_EQ(edges_.size(), graph_.n_edges());
+  // several weights per vertex pair spill out of the inline storage
+  for (double weight : {5., 6., 7.}) {
+    graph_.add_edge(std::make_shared<edge>(verts_[0], verts_[1], weight));
+    ASSERT_TRUE(graph_.has_edge(edge(verts_[0], verts_[1], weight)));
+  }
+  ASSERT_EQ(edges_.size() + 3, graph_.n_edges());
+  ASSERT_TRUE(graph_.has_edge(edges_[0]));
+  // edges bring in their vertices
+  vertex_ptr other = std::make_shared<vertex>(4);
+  graph_.add_edge(std::make_shared<edge>(verts_[0], other));
+  ASSERT_TRUE(graph_.has_vertex(other));
+  ASSERT_EQ(verts_.size() + 1, graph_.n_vertices());
+  ASSERT_TRUE(graph_.connects(other, verts_[0]));
+  graph_.add_vertex(other);
+  ASSERT_EQ(verts_.size() + 1, graph_.n_vertices());
+}
+
+/**
+ * Test that lookups give the same answers with the edge Bloom filter.
+ *
+ * Enough edges are added after enabling the filter that it is rebuilt.
+ */
+TEST_F(GraphTest, EdgeFilterTest)
+{
+  ASSERT_FALSE(graph_.has_edge_filter());
+  graph_.enable_edge_filter();
+  ASSERT_TRUE(graph_.has_edge_filter());
+  vertex_ptr_vector others;
+  for (int i = 0; i < 100; i++) {
+    others.push_back(std::make_shared<vertex>(i));
+    graph_.add_edge(std::make_shared<edge>(verts_[i % 3], others.back(), i));
+  }
+  edge_ptr_vector_ptr edges = graph_.edges();
+  for (const edge_ptr& arc : *edges) {
+    ASSERT_TRUE(graph_.has_edge(arc));
+    ASSERT_TRUE(graph_.connects(arc->start(), arc->end(), false));
+  }
+  for (int i = 0; i < 100; i++) {
+    ASSERT_FALSE(graph_.connects(others[i], verts_[i % 3], false));
+    ASSERT_TRUE(graph_.connects(others[i], verts_[i % 3]));
+    ASSERT_FALSE(graph_.connects(verts_[(i + 1) % 3], others[i]));
+  }
+  ASSERT_FALSE(graph_.connects(verts_[0], verts_[0]));
+  graph_.disable_edge_filter();
+  ASSERT_FALSE(graph_.has_edge_filter());
+  ASSERT_TRUE(graph_.has_edge(edges_[0]));
+}
+
 }  // namespace
 
 }  // namespace testing
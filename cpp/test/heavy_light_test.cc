@@ -0,0 +1,187 @@
+/**
+ * @file heavy_light_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for heavy-light decomposition in heavy_light.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/heavy_light.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a random valued tree and the parent of each node.
+ *
+ * Node `i > 0` hangs off a random earlier node, mostly a recent one, so the
+ * tree has long paths as well as many light edges.
+ */
+class HeavyLightTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the tree.
+   */
+  HeavyLightTest() : nodes_(n_nodes_), parents_(n_nodes_, 0)
+  {
+    std::mt19937_64 rng(70);
+    std::uniform_real_distribution<double> values(-10, 10);
+    std::vector<tree_ptr_vector> children(n_nodes_);
+    for (std::size_t i = 1; i < n_nodes_; i++) {
+      // mostly short hops, giving long paths, and sometimes any earlier node
+      bool short_hop = rng() % 4;
+      std::size_t span = short_hop ? std::min<std::size_t>(3, i) : i;
+      parents_[i] = i - 1 - rng() % span;
+    }
+    for (std::size_t i = n_nodes_; i-- > 0; ) {
+      nodes_[i] = std::make_shared<tree>(
+        values(rng), std::make_shared<tree_ptr_vector>(std::move(children[i]))
+      );
+      if (i) {
+        children[parents_[i]].push_back(nodes_[i]);
+      }
+    }
+  }
+
+  /**
+   * Return the path aggregate by walking up parent links.
+   *
+   * Parents always have smaller labels, so the larger label moves up.
+   *
+   * @param u `std::size_t` first node label
+   * @param v `std::size_t` second node label
+   */
+  path_aggregate naive_path(std::size_t u, std::size_t v) const
+  {
+    path_aggregate result;
+    auto add = [&](std::size_t w)
+    {
+      double value = nodes_[w]->value();
+      result.sum += value;
+      result.min = std::min(result.min, value);
+      result.max = std::max(result.max, value);
+    };
+    while (u != v) {
+      if (u < v) {
+        std::swap(u, v);
+      }
+      add(u);
+      u = parents_[u];
+    }
+    add(u);
+    return result;
+  }
+
+  /**
+   * Check every path query from one node against parent walks.
+   *
+   * @param hld `const heavy_light&` decomposition of the tree
+   * @param u `std::size_t` node label
+   */
+  void check_paths(const heavy_light& hld, std::size_t u) const
+  {
+    for (std::size_t v = 0; v < n_nodes_; v++) {
+      path_aggregate expected = naive_path(u, v);
+      path_aggregate actual = hld.query_path(
+        hld.index(nodes_[u]), hld.index(nodes_[v])
+      );
+      ASSERT_NEAR(expected.sum, actual.sum, 1e-9);
+      ASSERT_EQ(expected.min, actual.min);
+      ASSERT_EQ(expected.max, actual.max);
+    }
+  }
+
+  static constexpr std::size_t n_nodes_ = 400;
+  tree_ptr_vector nodes_;
+  std::vector<std::size_t> parents_;
+};
+
+/**
+ * Test that heavy paths are contiguous and cross few light edges.
+ */
+TEST_F(HeavyLightTest, LayoutTest)
+{
+  heavy_light hld(nodes_[0]);
+  ASSERT_EQ(n_nodes_, hld.n_nodes());
+  ASSERT_EQ(0, hld.index(nodes_[0]));
+  for (std::size_t i = 1; i < n_nodes_; i++) {
+    vertex_index v = hld.index(nodes_[i]);
+    ASSERT_EQ(nodes_[i], hld.node(v));
+    ASSERT_EQ(nodes_[parents_[i]], hld.node(hld.parent(v)));
+    ASSERT_EQ(hld.depth(hld.parent(v)) + 1, hld.depth(v));
+    if (hld.head(v) != v) {
+      ASSERT_EQ(v - 1, hld.parent(v));
+      ASSERT_EQ(hld.head(v - 1), hld.head(v));
+    }
+    // each light edge at least halves the subtree size
+    std::size_t n_light = 0;
+    for (vertex_index w = v; w; w = hld.parent(hld.head(w))) {
+      n_light += (hld.head(w) != 0);
+    }
+    ASSERT_LE(n_light, 9);
+  }
+}
+
+/**
+ * Test path queries against parent walks before and after value updates.
+ */
+TEST_F(HeavyLightTest, QueryTest)
+{
+  heavy_light hld(nodes_[0]);
+  for (std::size_t u = 0; u < n_nodes_; u += 7) {
+    check_paths(hld, u);
+  }
+  std::mt19937_64 rng(8);
+  for (std::size_t i = 0; i < 100; i++) {
+    vertex_index v = static_cast<vertex_index>(rng() % n_nodes_);
+    hld.set_value(v, static_cast<double>(rng() % 100) - 50);
+    ASSERT_EQ(hld.node(v)->value(), hld.value(v));
+  }
+  for (std::size_t u = 3; u < n_nodes_; u += 7) {
+    check_paths(hld, u);
+  }
+  vertex_index five = hld.index(nodes_[5]);
+  ASSERT_EQ(nodes_[5]->value(), hld.path_sum(five, five));
+}
+
+/**
+ * Test root-to-node queries on a `binary_tree` with missing children.
+ */
+TEST_F(HeavyLightTest, BinaryTreeTest)
+{
+  auto root = std::make_shared<binary_tree>(5);
+  for (double value : {3., 8., 1., 4., 9., 10.}) {
+    root->insert(value);
+  }
+  heavy_light hld(root);
+  ASSERT_EQ(7, hld.n_nodes());
+  vertex_index ten = hld.index(root->right()->right()->right());
+  vertex_index one = hld.index(root->left()->left());
+  ASSERT_EQ(32, hld.path_sum(0, ten));
+  ASSERT_EQ(5, hld.path_min(0, ten));
+  ASSERT_EQ(36, hld.path_sum(one, ten));
+  ASSERT_EQ(1, hld.path_min(one, ten));
+  ASSERT_EQ(10, hld.path_max(one, ten));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
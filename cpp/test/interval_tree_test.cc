@@ -0,0 +1,113 @@
+/**
+ * @file interval_tree_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the static augmented interval tree
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/interval_tree.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with random intervals of widely varying lengths.
+ *
+ * The count is not of the form `2^h - 1`, so the tree has padding.
+ */
+class IntervalTreeTest : public ::testing::Test {
+protected:
+  IntervalTreeTest() : rng_(72)
+  {
+    std::uniform_real_distribution<double> starts(0, 1000);
+    std::exponential_distribution<double> lengths(0.05);
+    for (std::size_t i = 0; i < 1500; i++) {
+      double start = starts(rng_);
+      intervals_.emplace_back(start, start + lengths(rng_));
+    }
+    // repeated and degenerate intervals
+    intervals_.push_back(intervals_.front());
+    intervals_.emplace_back(500, 500);
+  }
+
+  /**
+   * Return positions of intervals overlapping `[low, high]` by brute force.
+   *
+   * @param low `double` start of the query interval
+   * @param high `double` end of the query interval
+   */
+  std::vector<std::size_t> naive_overlap(double low, double high) const
+  {
+    std::vector<std::size_t> result;
+    for (std::size_t i = 0; i < intervals_.size(); i++) {
+      if (intervals_[i].first <= high && intervals_[i].second >= low) {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  std::mt19937_64 rng_;
+  std::vector<double_pair> intervals_;
+};
+
+/**
+ * Test that an empty tree reports nothing.
+ */
+TEST_F(IntervalTreeTest, EmptyTest)
+{
+  interval_tree tree;
+  std::vector<std::size_t> out;
+  ASSERT_EQ(0, tree.size());
+  ASSERT_EQ(0, tree.stab(1, out));
+  ASSERT_TRUE(out.empty());
+}
+
+/**
+ * Test random stabbing and overlap queries against brute force.
+ */
+TEST_F(IntervalTreeTest, QueryTest)
+{
+  interval_tree tree(intervals_);
+  ASSERT_EQ(intervals_.size(), tree.size());
+  std::uniform_real_distribution<double> points(-10, 1010);
+  std::vector<std::size_t> out;
+  for (std::size_t i = 0; i < 500; i++) {
+    double low = points(rng_);
+    double high = (i % 2) ? low : low + points(rng_) / 20;
+    out.clear();
+    std::size_t n_found = (i % 2)
+      ? tree.stab(low, out) : tree.overlap(low, high, out);
+    ASSERT_EQ(out.size(), n_found);
+    std::sort(out.begin(), out.end());
+    ASSERT_EQ(naive_overlap(low, high), out);
+  }
+  // closed intervals share endpoints, and the buffer is appended to
+  out.assign(1, 0);
+  ASSERT_EQ(naive_overlap(500, 500).size(), tree.stab(500, out));
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  out.clear();
+  ASSERT_EQ(intervals_.size(), tree.overlap(-inf, inf, out));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
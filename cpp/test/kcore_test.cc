@@ -0,0 +1,123 @@
+/**
+ * @file kcore_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the k-core decomposition in kcore.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/kcore.h"
+
+#include <cstddef>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a 4-clique, a triangle tail, and an isolated vertex.
+ */
+class KCoreTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the graph.
+   *
+   * Vertices 0 - 3 form a 4-clique (3-core), 3 - 4 - 5 - 3 is a triangle
+   * hanging off the clique (2-core), 6 hangs off 5 (1-core), 7 is isolated,
+   * and 0 has a self-loop that should be ignored.
+   */
+  KCoreTest()
+    : graph_(
+        csr_graph(
+          8,
+          vertex_index_vector({0, 0, 0, 1, 1, 2, 3, 4, 5, 5, 0}),
+          vertex_index_vector({1, 2, 3, 2, 3, 3, 4, 5, 3, 6, 0})
+        ).symmetrize()
+      )
+  {}
+
+  const csr_graph graph_;
+  static const vertex_index_vector expected_cores_;
+};
+
+const vertex_index_vector KCoreTest::expected_cores_ = {
+  3, 3, 3, 3, 2, 2, 1, 0
+};
+
+/**
+ * Test that bucket-queue peeling gives the expected core numbers.
+ */
+TEST_F(KCoreTest, SequentialTest)
+{
+  ASSERT_EQ(expected_cores_, core_numbers(graph_));
+}
+
+/**
+ * Test that parallel peeling gives the expected core numbers.
+ */
+TEST_F(KCoreTest, ParallelTest)
+{
+  ASSERT_EQ(expected_cores_, parallel_core_numbers(graph_, 3));
+}
+
+/**
+ * Test that the peeling order removes each vertex at its core degree.
+ *
+ * When a vertex is removed, its neighbors later in the order are the ones
+ * still present, and there can be no more of them than its core number.
+ */
+TEST_F(KCoreTest, PeelOrderTest)
+{
+  degeneracy_peeling peeling = peel_by_degree(graph_);
+  ASSERT_EQ(expected_cores_, peeling.cores);
+  std::size_t n_vertices = graph_.n_vertices();
+  ASSERT_EQ(n_vertices, peeling.order.size());
+  vertex_index_vector ranks(n_vertices, n_vertices);
+  for (std::size_t i = 0; i < n_vertices; i++) {
+    ranks[peeling.order[i]] = static_cast<vertex_index>(i);
+  }
+  for (vertex_index v = 0; v < n_vertices; v++) {
+    ASSERT_NE(n_vertices, ranks[v]);
+    vertex_index n_later = 0;
+    graph_.for_each_neighbor(
+      v, [&](vertex_index u, edge_index) { n_later += ranks[u] > ranks[v]; }
+    );
+    ASSERT_LE(n_later, peeling.cores[v]);
+  }
+}
+
+/**
+ * Test that both variants agree on a larger random graph.
+ */
+TEST(KCoreRandomTest, AgreementTest)
+{
+  std::size_t n_vertices = 5000;
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<vertex_index> dist(0, n_vertices - 1);
+  vertex_index_vector sources(40000);
+  vertex_index_vector targets(sources.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    // squaring skews the degree distribution towards low indices
+    vertex_index u = dist(rng);
+    sources[i] = static_cast<vertex_index>(u * (u / double(n_vertices)));
+    targets[i] = dist(rng);
+  }
+  csr_graph graph = csr_graph(n_vertices, sources, targets).symmetrize();
+  ASSERT_EQ(core_numbers(graph), parallel_core_numbers(graph, 4));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,170 @@
+/**
+ * @file lca_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for lowest common ancestor queries in lca.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/lca.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a random tree and the parent of each of its nodes.
+ *
+ * Node `i > 0` hangs off a random earlier node, mostly a recent one, so the
+ * tree is both deep and bushy.
+ */
+class LcaTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the tree.
+   */
+  LcaTest() : nodes_(n_nodes_), parents_(n_nodes_, 0)
+  {
+    std::mt19937_64 rng(69);
+    std::vector<tree_ptr_vector> children(n_nodes_);
+    for (std::size_t i = 1; i < n_nodes_; i++) {
+      // mostly short hops, giving deep paths, and sometimes any earlier node
+      bool short_hop = rng() % 4;
+      std::size_t span = short_hop ? std::min<std::size_t>(3, i) : i;
+      parents_[i] = i - 1 - rng() % span;
+    }
+    for (std::size_t i = n_nodes_; i-- > 0; ) {
+      nodes_[i] = std::make_shared<tree>(
+        static_cast<double>(i),
+        std::make_shared<tree_ptr_vector>(std::move(children[i]))
+      );
+      if (i) {
+        children[parents_[i]].push_back(nodes_[i]);
+      }
+    }
+  }
+
+  /**
+   * Return the lowest common ancestor by walking up parent links.
+   *
+   * Parents always have smaller labels, so the larger label moves up.
+   *
+   * @param u `std::size_t` first node label
+   * @param v `std::size_t` second node label
+   */
+  std::size_t naive_lca(std::size_t u, std::size_t v) const
+  {
+    while (u != v) {
+      if (u > v) {
+        u = parents_[u];
+      }
+      else {
+        v = parents_[v];
+      }
+    }
+    return u;
+  }
+
+  static constexpr std::size_t n_nodes_ = 300;
+  tree_ptr_vector nodes_;
+  std::vector<std::size_t> parents_;
+};
+
+/**
+ * Test that the index numbers nodes in pre-order with correct parents.
+ */
+TEST_F(LcaTest, LayoutTest)
+{
+  lca_index index(nodes_[0]);
+  ASSERT_EQ(n_nodes_, index.n_nodes());
+  ASSERT_EQ(0, index.index(nodes_[0]));
+  ASSERT_EQ(0, index.parent(0));
+  ASSERT_EQ(0, index.depth(0));
+  for (std::size_t i = 1; i < n_nodes_; i++) {
+    vertex_index v = index.index(nodes_[i]);
+    ASSERT_EQ(nodes_[i], index.node(v));
+    ASSERT_EQ(nodes_[parents_[i]], index.node(index.parent(v)));
+    ASSERT_LT(index.parent(v), v);
+    ASSERT_EQ(index.depth(index.parent(v)) + 1, index.depth(v));
+  }
+}
+
+/**
+ * Test the sparse table index against parent walks for every pair.
+ */
+TEST_F(LcaTest, SparseTableTest)
+{
+  lca_index index(nodes_[0]);
+  for (std::size_t u = 0; u < n_nodes_; u++) {
+    for (std::size_t v = 0; v < n_nodes_; v++) {
+      ASSERT_EQ(nodes_[naive_lca(u, v)], index.lca(nodes_[u], nodes_[v]));
+    }
+  }
+}
+
+/**
+ * Test offline Tarjan queries against parent walks.
+ */
+TEST_F(LcaTest, TarjanTest)
+{
+  std::mt19937_64 rng(8);
+  tree_ptr_vector firsts;
+  tree_ptr_vector seconds;
+  std::vector<std::size_t> expected;
+  for (std::size_t q = 0; q < 3000; q++) {
+    std::size_t u = rng() % n_nodes_;
+    std::size_t v = (q % 10) ? rng() % n_nodes_ : u;
+    firsts.push_back(nodes_[u]);
+    seconds.push_back(nodes_[v]);
+    expected.push_back(naive_lca(u, v));
+  }
+  tree_ptr_vector result = tarjan_lca(nodes_[0], firsts, seconds);
+  ASSERT_EQ(firsts.size(), result.size());
+  for (std::size_t q = 0; q < result.size(); q++) {
+    ASSERT_EQ(nodes_[expected[q]], result[q]);
+  }
+}
+
+/**
+ * Test that missing `binary_tree` children are skipped.
+ */
+TEST_F(LcaTest, BinaryTreeTest)
+{
+  auto root = std::make_shared<binary_tree>(5);
+  for (double value : {3., 8., 1., 4., 9.}) {
+    root->insert(value);
+  }
+  lca_index index(root);
+  ASSERT_EQ(6, index.n_nodes());
+  tree_ptr one = root->left()->left();
+  tree_ptr four = root->left()->right();
+  tree_ptr nine = root->right()->right();
+  ASSERT_EQ(root->left(), index.lca(one, four));
+  ASSERT_EQ(root, index.lca(four, nine));
+  ASSERT_EQ(root->right(), index.lca(nine, root->right()));
+  ASSERT_EQ(
+    tree_ptr_vector({root->left(), root}),
+    tarjan_lca(root, {one, nine}, {four, four})
+  );
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,170 @@
+/**
+ * @file matching_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the matching algorithms in matching.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/matching.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/flow.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Check that a matching is consistent and only uses graph edges.
+ *
+ * @param graph `const csr_graph&` bipartite graph
+ * @param matching `const bipartite_matching&` matching to check
+ */
+void check_matching(const csr_graph& graph, const bipartite_matching& matching)
+{
+  std::size_t n_matched = 0;
+  for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+    vertex_index mate = matching.mates[v];
+    if (mate == unmatched) {
+      continue;
+    }
+    n_matched++;
+    ASSERT_EQ(v, matching.mates[mate]);
+    ASSERT_TRUE(graph.has_edge(v, mate) || graph.has_edge(mate, v));
+  }
+  ASSERT_EQ(2 * matching.size, n_matched);
+}
+
+/**
+ * Test Hopcroft-Karp on a graph where greedy matching is not maximum.
+ */
+TEST(HopcroftKarpTest, SmallTest)
+{
+  // left 0 - 2, right 3 - 5. greedy 0 - 3 blocks 1, which only likes 3
+  csr_graph graph(
+    6,
+    vertex_index_vector({0, 0, 1, 2, 2}),
+    vertex_index_vector({3, 4, 3, 4, 5})
+  );
+  std::vector<bool> left_side = {true, true, true, false, false, false};
+  bipartite_matching matching = hopcroft_karp(graph, left_side);
+  ASSERT_EQ(3, matching.size);
+  check_matching(graph, matching);
+  ASSERT_EQ(3, matching.mates[1]);
+}
+
+/**
+ * Test Hopcroft-Karp against max flow on random bipartite graphs.
+ */
+TEST(HopcroftKarpTest, RandomTest)
+{
+  std::mt19937 rng(17);
+  std::size_t n_left = 40;
+  std::size_t n_right = 30;
+  std::uniform_int_distribution<vertex_index> left_dist(0, n_left - 1);
+  std::uniform_int_distribution<vertex_index> right_dist(0, n_right - 1);
+  for (std::size_t trial = 0; trial < 10; trial++) {
+    vertex_index_vector sources;
+    vertex_index_vector targets;
+    for (std::size_t i = 0; i < 60; i++) {
+      sources.push_back(left_dist(rng));
+      targets.push_back(static_cast<vertex_index>(n_left + right_dist(rng)));
+    }
+    // symmetrize to check that right-to-left edges are ignored
+    csr_graph graph = csr_graph(
+      n_left + n_right, sources, targets
+    ).symmetrize();
+    std::vector<bool> left_side(n_left + n_right, false);
+    std::fill(left_side.begin(), left_side.begin() + n_left, true);
+    bipartite_matching matching = hopcroft_karp(graph, left_side);
+    check_matching(graph, matching);
+    // unit-capacity flow network with source and sink appended
+    vertex_index source = static_cast<vertex_index>(n_left + n_right);
+    vertex_index sink = source + 1;
+    for (vertex_index v = 0; v < source; v++) {
+      sources.push_back((left_side[v]) ? source : v);
+      targets.push_back((left_side[v]) ? v : sink);
+    }
+    csr_graph network(sink + 1, sources, targets);
+    ASSERT_DOUBLE_EQ(
+      dinic_max_flow(network, source, sink).value, double(matching.size)
+    );
+  }
+}
+
+/**
+ * Return the brute-force minimum assignment cost.
+ *
+ * @param costs `const double_vector&` row-major cost matrix
+ * @param n_rows `std::size_t` number of rows
+ * @param n_cols `std::size_t` number of columns
+ */
+double brute_force_cost(
+  const double_vector& costs, std::size_t n_rows, std::size_t n_cols)
+{
+  std::size_t n = std::max(n_rows, n_cols);
+  std::vector<std::size_t> perm(n);
+  for (std::size_t i = 0; i < n; i++) {
+    perm[i] = i;
+  }
+  double best = std::numeric_limits<double>::infinity();
+  do {
+    double cost = 0;
+    for (std::size_t i = 0; i < n_rows; i++) {
+      if (perm[i] < n_cols) {
+        cost += costs[i * n_cols + perm[i]];
+      }
+    }
+    best = std::min(best, cost);
+  } while (std::next_permutation(perm.begin(), perm.end()));
+  return best;
+}
+
+/**
+ * Test the Hungarian algorithm against brute force, including rectangles.
+ */
+TEST(HungarianTest, BruteForceTest)
+{
+  std::mt19937 rng(19);
+  std::uniform_real_distribution<double> cost_dist(0, 10);
+  for (auto shape : {std::make_pair(5, 5), {3, 6}, {6, 3}}) {
+    std::size_t n_rows = shape.first;
+    std::size_t n_cols = shape.second;
+    double_vector costs(n_rows * n_cols);
+    for (double& cost : costs) {
+      cost = cost_dist(rng);
+    }
+    assignment result = hungarian_assignment(costs, n_rows, n_cols);
+    ASSERT_NEAR(brute_force_cost(costs, n_rows, n_cols), result.cost, 1e-9);
+    std::vector<bool> used(n_cols, false);
+    std::size_t n_assigned = 0;
+    for (vertex_index col : result.columns) {
+      if (col != unmatched) {
+        ASSERT_FALSE(used[col]);
+        used[col] = true;
+        n_assigned++;
+      }
+    }
+    ASSERT_EQ(std::min(n_rows, n_cols), n_assigned);
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
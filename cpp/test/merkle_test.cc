@@ -0,0 +1,126 @@
+/**
+ * @file merkle_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for Merkle hashing of trees in merkle.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/merkle.h"
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture that builds pairs of identical random trees.
+ */
+class MerkleTest : public ::testing::Test {
+protected:
+  /**
+   * Return a random tree, the same one for the same seed.
+   *
+   * @param seed `unsigned int` random seed
+   * @param nodes `tree_ptr_vector&` filled with the nodes in creation order
+   */
+  tree_ptr make_tree(unsigned int seed, tree_ptr_vector& nodes) const
+  {
+    std::mt19937 rng(seed);
+    std::vector<tree_ptr_vector> children(n_nodes_);
+    std::vector<std::size_t> parents(n_nodes_, 0);
+    for (std::size_t i = 1; i < n_nodes_; i++) {
+      parents[i] = rng() % i;
+    }
+    nodes.assign(n_nodes_, nullptr);
+    for (std::size_t i = n_nodes_; i-- > 0; ) {
+      nodes[i] = std::make_shared<tree>(
+        static_cast<double>(rng() % 10),
+        std::make_shared<tree_ptr_vector>(children[i])
+      );
+      if (i) {
+        children[parents[i]].push_back(nodes[i]);
+      }
+    }
+    return nodes[0];
+  }
+
+  static constexpr std::size_t n_nodes_ = 500;
+};
+
+/**
+ * Test that equal trees hash equally and that any edit changes the hash.
+ */
+TEST_F(MerkleTest, EqualityTest)
+{
+  tree_ptr_vector first_nodes;
+  tree_ptr_vector second_nodes;
+  merkle_hashes first(make_tree(1, first_nodes));
+  merkle_hashes second(make_tree(1, second_nodes));
+  ASSERT_EQ(n_nodes_, first.size());
+  ASSERT_EQ(first, second);
+  ASSERT_NE(first, merkle_hashes(make_tree(2, second_nodes)));
+  ASSERT_EQ(second_nodes[0], merkle_hashes(second_nodes[0]).root());
+  // -0.0 and 0.0 compare equal, and so do all NAN values here
+  ASSERT_EQ(merkle_value_hash(-0.), merkle_value_hash(0.));
+  ASSERT_EQ(merkle_value_hash(NAN), merkle_value_hash(-NAN));
+  // swapping two children changes the hash
+  auto parent = std::make_shared<tree>(1, tree::make_children({2, 3}));
+  auto swapped = std::make_shared<tree>(1, tree::make_children({3, 2}));
+  ASSERT_NE(merkle_hashes(parent), merkle_hashes(swapped));
+  // a missing child is not the same as no child
+  auto with_null = std::make_shared<tree>(
+    1, std::make_shared<tree_ptr_vector>(tree_ptr_vector{nullptr})
+  );
+  ASSERT_NE(
+    merkle_hashes(with_null), merkle_hashes(std::make_shared<tree>(1))
+  );
+}
+
+/**
+ * Test that diffing finds exactly the edited nodes.
+ */
+TEST_F(MerkleTest, DiffTest)
+{
+  tree_ptr_vector first_nodes;
+  tree_ptr_vector second_nodes;
+  tree_ptr first_root = make_tree(3, first_nodes);
+  tree_ptr second_root = make_tree(3, second_nodes);
+  merkle_hashes first(first_root);
+  ASSERT_TRUE(first.diff(merkle_hashes(second_root)).empty());
+  // change one value and give one node an extra child
+  second_nodes[100]->set_value(-1);
+  auto grown = std::make_shared<tree_ptr_vector>(
+    *second_nodes[200]->children()
+  );
+  grown->push_back(std::make_shared<tree>(7));
+  second_nodes[200]->set_children(grown);
+  changed_node_vector changes = first.diff(merkle_hashes(second_root));
+  ASSERT_EQ(2, changes.size());
+  for (const auto& [before, after] : changes) {
+    bool value_edit = after == second_nodes[100].get();
+    ASSERT_TRUE(value_edit || after == second_nodes[200].get());
+    std::size_t label = value_edit ? 100 : 200;
+    ASSERT_EQ(first_nodes[label].get(), before);
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,129 @@
+/**
+ * @file mst_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the minimum spanning tree algorithms in mst.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/mst.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a small weighted graph with two components.
+ */
+class MstTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the graph.
+   *
+   * The first component is the square 0 - 1 - 2 - 3 - 0 with diagonal 0 - 2,
+   * the second is the single edge 4 - 5.
+   */
+  MstTest()
+    : graph_(
+        csr_graph(
+          6,
+          vertex_index_vector({0, 1, 2, 3, 0, 4}),
+          vertex_index_vector({1, 2, 3, 0, 2, 5}),
+          double_vector({1, 4, 2, 5, 3, 7})
+        ).symmetrize()
+      )
+  {}
+
+  /**
+   * Check that a forest has the expected edges and weight.
+   *
+   * @param forest `const spanning_forest&` forest to check
+   */
+  void check_forest(const spanning_forest& forest) const
+  {
+    edge_index_vector edges(forest.edges);
+    std::sort(edges.begin(), edges.end());
+    // edges 0 - 1, 0 - 2, 2 - 3, 4 - 5 in CSR order
+    ASSERT_EQ(edge_index_vector({0, 1, 7, 10}), edges);
+    ASSERT_DOUBLE_EQ(13, forest.total_weight);
+  }
+
+  const csr_graph graph_;
+};
+
+/**
+ * Test that Kruskal's algorithm gives the expected forest.
+ */
+TEST_F(MstTest, KruskalTest)
+{
+  check_forest(kruskal_mst(graph_));
+}
+
+/**
+ * Test that Prim's algorithm gives the expected forest.
+ */
+TEST_F(MstTest, PrimTest)
+{
+  check_forest(prim_mst(graph_));
+}
+
+/**
+ * Test that Borůvka's algorithm gives the expected forest.
+ */
+TEST_F(MstTest, BoruvkaTest)
+{
+  check_forest(boruvka_mst(graph_, 2));
+}
+
+/**
+ * Test that all algorithms agree on a larger random graph.
+ *
+ * The graph is large enough for the parallel sort in Kruskal's algorithm to
+ * actually split the work across threads.
+ */
+TEST(MstRandomTest, AgreementTest)
+{
+  std::size_t n_vertices = 2000;
+  std::size_t n_edges = 100000;
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<vertex_index> vert_dist(0, n_vertices - 1);
+  std::uniform_real_distribution<double> weight_dist(0, 1);
+  vertex_index_vector sources(n_edges);
+  vertex_index_vector targets(n_edges);
+  double_vector weights(n_edges);
+  for (std::size_t i = 0; i < n_edges; i++) {
+    sources[i] = vert_dist(rng);
+    targets[i] = vert_dist(rng);
+    weights[i] = weight_dist(rng);
+  }
+  csr_graph graph = csr_graph(
+    n_vertices, sources, targets, weights
+  ).symmetrize();
+  spanning_forest kruskal = kruskal_mst(graph, 4);
+  spanning_forest prim = prim_mst(graph);
+  spanning_forest boruvka = boruvka_mst(graph, 4);
+  ASSERT_EQ(n_vertices - 1, kruskal.edges.size());
+  ASSERT_EQ(kruskal.edges.size(), prim.edges.size());
+  ASSERT_EQ(kruskal.edges.size(), boruvka.edges.size());
+  ASSERT_NEAR(kruskal.total_weight, prim.total_weight, 1e-9);
+  ASSERT_NEAR(kruskal.total_weight, boruvka.total_weight, 1e-9);
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,116 @@
+/**
+ * @file pagerank_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the PageRank implementation in pagerank.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/pagerank.h"
+
+#include <cstddef>
+#include <numeric>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a small graph that has a dangling vertex.
+ */
+class PageRankTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the graph.
+   *
+   * Edges are 0 -> {1, 2}, 1 -> 2, 2 -> 0, 3 -> 2, and vertex 4 is dangling
+   * but pointed to by 3.
+   */
+  PageRankTest()
+    : graph_(
+        5,
+        vertex_index_vector({0, 0, 1, 2, 3, 3}),
+        vertex_index_vector({1, 2, 2, 0, 2, 4})
+      )
+  {}
+
+  /**
+   * Compute PageRank with a plain dense power iteration for reference.
+   *
+   * @param teleport `const double_vector&` normalized teleport distribution
+   */
+  double_vector reference_ranks(const double_vector& teleport) const
+  {
+    std::size_t n = graph_.n_vertices();
+    double_vector ranks(teleport);
+    for (std::size_t iteration = 0; iteration < 1000; iteration++) {
+      double_vector next(n, 0);
+      for (vertex_index u = 0; u < n; u++) {
+        for (vertex_index v = 0; v < n; v++) {
+          double follow = (graph_.degree(u)) ? 0 : teleport[v];
+          if (graph_.has_edge(u, v)) {
+            follow = 1. / graph_.degree(u);
+          }
+          next[v] +=
+            ranks[u] * (damping_ * follow + (1 - damping_) * teleport[v]);
+        }
+      }
+      ranks = next;
+    }
+    return ranks;
+  }
+
+  const csr_graph graph_;
+  static const double damping_;
+};
+
+const double PageRankTest::damping_ = 0.85;
+
+/**
+ * Test that standard PageRank matches the dense reference.
+ */
+TEST_F(PageRankTest, UniformTest)
+{
+  pagerank ranker(graph_, damping_, 2);
+  double_vector ranks;
+  std::size_t n_iterations = ranker.solve(ranks);
+  ASSERT_LT(n_iterations, 100);
+  ASSERT_NEAR(1, std::accumulate(ranks.begin(), ranks.end(), 0.), 1e-9);
+  double_vector expected = reference_ranks(double_vector(5, 0.2));
+  for (std::size_t v = 0; v < ranks.size(); v++) {
+    ASSERT_NEAR(expected[v], ranks[v], 1e-9);
+  }
+  // warm start from the converged ranks takes a single iteration
+  ASSERT_EQ(1, ranker.solve(ranks, 1e-9));
+}
+
+/**
+ * Test that personalized PageRank matches the dense reference.
+ */
+TEST_F(PageRankTest, PersonalizedTest)
+{
+  pagerank ranker(graph_, damping_);
+  double_vector ranks;
+  ranker.solve(ranks, double_vector({0, 0, 0, 3, 1}));
+  double_vector expected = reference_ranks(
+    double_vector({0, 0, 0, 0.75, 0.25})
+  );
+  for (std::size_t v = 0; v < ranks.size(); v++) {
+    ASSERT_NEAR(expected[v], ranks[v], 1e-9);
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
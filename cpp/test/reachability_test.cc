@@ -0,0 +1,162 @@
+/**
+ * @file reachability_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the DAG reachability index in reachability.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/reachability.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a random DAG whose vertices are randomly numbered.
+ *
+ * The DAG has far more vertices than landmarks, so some queries need the
+ * pruned search fallback.
+ */
+class ReachabilityIndexTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the DAG.
+   */
+  ReachabilityIndexTest()
+  {
+    std::mt19937_64 rng(68);
+    vertex_index_vector labels(n_vertices_);
+    std::iota(labels.begin(), labels.end(), 0);
+    std::shuffle(labels.begin(), labels.end(), rng);
+    // edges only go from lower to higher rank, with mostly short spans
+    vertex_index_vector sources;
+    vertex_index_vector targets;
+    std::geometric_distribution<vertex_index> spans(0.05);
+    for (std::size_t i = 0; i < 2 * n_vertices_; i++) {
+      vertex_index rank = static_cast<vertex_index>(rng() % n_vertices_);
+      vertex_index other = rank + 1 + spans(rng);
+      if (other < n_vertices_) {
+        sources.push_back(labels[rank]);
+        targets.push_back(labels[other]);
+      }
+    }
+    dag_ = csr_graph(n_vertices_, sources, targets);
+  }
+
+  /**
+   * Return reachability of every vertex pair by breadth-first search.
+   */
+  std::vector<std::vector<bool>> closure() const
+  {
+    std::vector<std::vector<bool>> result(n_vertices_);
+    for (vertex_index source = 0; source < n_vertices_; source++) {
+      std::vector<bool>& seen = result[source];
+      seen.assign(n_vertices_, false);
+      seen[source] = true;
+      vertex_index_vector queue{source};
+      for (std::size_t i = 0; i < queue.size(); i++) {
+        dag_.for_each_neighbor(
+          queue[i],
+          [&](vertex_index u, edge_index)
+          {
+            if (!seen[u]) {
+              seen[u] = true;
+              queue.push_back(u);
+            }
+          }
+        );
+      }
+    }
+    return result;
+  }
+
+  static constexpr std::size_t n_vertices_ = 400;
+  csr_graph dag_;
+};
+
+/**
+ * Test that every pair agrees with breadth-first search.
+ */
+TEST_F(ReachabilityIndexTest, ClosureTest)
+{
+  reachability_index index(dag_);
+  ASSERT_EQ(n_vertices_, index.n_vertices());
+  ASSERT_EQ(64, index.n_landmarks());
+  std::vector<std::vector<bool>> expected = closure();
+  for (vertex_index u = 0; u < n_vertices_; u++) {
+    for (vertex_index v = 0; v < n_vertices_; v++) {
+      ASSERT_EQ(expected[u][v], index.reachable(u, v)) << u << " -> " << v;
+    }
+  }
+}
+
+/**
+ * Test that batched queries match single queries, with more landmarks.
+ */
+TEST_F(ReachabilityIndexTest, BatchTest)
+{
+  reachability_index index(dag_, 3, 2);
+  ASSERT_EQ(192, index.n_landmarks());
+  std::mt19937_64 rng(8);
+  vertex_index_vector sources(5000);
+  vertex_index_vector targets(sources.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    sources[i] = static_cast<vertex_index>(rng() % n_vertices_);
+    targets[i] = static_cast<vertex_index>(rng() % n_vertices_);
+  }
+  std::vector<std::uint8_t> result = index.reachable(sources, targets, 2);
+  std::vector<std::vector<bool>> expected = closure();
+  ASSERT_EQ(sources.size(), result.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    ASSERT_EQ(expected[sources[i]][targets[i]], result[i]);
+  }
+}
+
+/**
+ * Test indexing a `graph` converted to a `csr_graph`.
+ */
+TEST_F(ReachabilityIndexTest, GraphTest)
+{
+  vertex_ptr_vector verts;
+  for (int i = 0; i < 4; i++) {
+    verts.push_back(std::make_shared<vertex>(i));
+  }
+  graph chain(
+    verts,
+    edge_ptr_vector{
+      std::make_shared<edge>(verts[0], verts[1]),
+      std::make_shared<edge>(verts[1], verts[2]),
+      std::make_shared<edge>(verts[3], verts[2])
+    }
+  );
+  reachability_index index(csr_graph(*chain.vertices(), *chain.edges()));
+  ASSERT_TRUE(index.reachable(0, 2));
+  ASSERT_FALSE(index.reachable(2, 0));
+  ASSERT_FALSE(index.reachable(0, 3));
+  ASSERT_TRUE(index.reachable(3, 2));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,189 @@
+/**
+ * @file reorder_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for vertex reordering in reorder.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/reorder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a grid graph whose vertex labels are shuffled.
+ */
+class ReorderTest : public ::testing::Test {
+protected:
+  /**
+   * Build a `side_ x side_` grid, then scatter its labels randomly.
+   */
+  ReorderTest()
+  {
+    std::size_t n_vertices = side_ * side_;
+    vertex_index_vector labels(n_vertices);
+    for (std::size_t v = 0; v < n_vertices; v++) {
+      labels[v] = static_cast<vertex_index>(v);
+    }
+    std::mt19937 rng(13);
+    std::shuffle(labels.begin(), labels.end(), rng);
+    vertex_index_vector sources;
+    vertex_index_vector targets;
+    for (std::size_t r = 0; r < side_; r++) {
+      for (std::size_t c = 0; c < side_; c++) {
+        if (c + 1 < side_) {
+          sources.push_back(labels[r * side_ + c]);
+          targets.push_back(labels[r * side_ + c + 1]);
+        }
+        if (r + 1 < side_) {
+          sources.push_back(labels[r * side_ + c]);
+          targets.push_back(labels[(r + 1) * side_ + c]);
+        }
+      }
+    }
+    graph_ = csr_graph(n_vertices, sources, targets).symmetrize();
+  }
+
+  /**
+   * Return the bandwidth of a graph, the largest `|u - v|` over its edges.
+   *
+   * @param graph `const csr_graph&` graph to measure
+   */
+  static std::size_t bandwidth(const csr_graph& graph)
+  {
+    std::size_t result = 0;
+    for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+      graph.for_each_neighbor(
+        v,
+        [&](vertex_index u, edge_index)
+        {
+          result = std::max<std::size_t>(result, (u > v) ? u - v : v - u);
+        }
+      );
+    }
+    return result;
+  }
+
+  /**
+   * Check that `perm` is a permutation and relabels `graph_` faithfully.
+   *
+   * @param perm `const vertex_index_vector&` new index of each vertex
+   * @returns `csr_graph` relabeled graph
+   */
+  csr_graph check_permutation(const vertex_index_vector& perm)
+  {
+    vertex_index_vector sorted(perm);
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t v = 0; v < sorted.size(); v++) {
+      EXPECT_EQ(v, sorted[v]);
+    }
+    csr_graph permuted = permute_vertices(graph_, perm, 3);
+    EXPECT_EQ(graph_.n_edges(), permuted.n_edges());
+    for (vertex_index v = 0; v < graph_.n_vertices(); v++) {
+      EXPECT_EQ(graph_.degree(v), permuted.degree(perm[v]));
+      graph_.for_each_neighbor(
+        v,
+        [&](vertex_index u, edge_index)
+        {
+          EXPECT_TRUE(permuted.has_edge(perm[v], perm[u]));
+        }
+      );
+    }
+    return permuted;
+  }
+
+  static constexpr std::size_t side_ = 30;
+  csr_graph graph_;
+};
+
+/**
+ * Test that reverse Cuthill-McKee shrinks the bandwidth of the grid.
+ */
+TEST_F(ReorderTest, CuthillMcKeeTest)
+{
+  csr_graph permuted = check_permutation(reverse_cuthill_mckee(graph_));
+  // a BFS ordering of a grid has bandwidth about one diagonal
+  ASSERT_LE(bandwidth(permuted), 2 * side_);
+  ASSERT_GT(bandwidth(graph_), 10 * side_);
+}
+
+/**
+ * Test that degree ordering sorts vertices by nonincreasing degree.
+ */
+TEST_F(ReorderTest, DegreeTest)
+{
+  csr_graph permuted = check_permutation(degree_ordering(graph_, 2));
+  for (vertex_index v = 1; v < permuted.n_vertices(); v++) {
+    ASSERT_GE(permuted.degree(v - 1), permuted.degree(v));
+  }
+}
+
+/**
+ * Test that Gorder places neighbors far closer than the shuffled labels.
+ */
+TEST_F(ReorderTest, GorderTest)
+{
+  csr_graph permuted = check_permutation(gorder(graph_));
+  auto mean_gap = [](const csr_graph& graph)
+  {
+    double total = 0;
+    for (vertex_index v = 0; v < graph.n_vertices(); v++) {
+      graph.for_each_neighbor(
+        v,
+        [&](vertex_index u, edge_index)
+        {
+          total += std::abs(static_cast<double>(u) - v);
+        }
+      );
+    }
+    return total / graph.n_edges();
+  };
+  ASSERT_LT(4 * mean_gap(permuted), mean_gap(graph_));
+}
+
+/**
+ * Test that weights and values follow their vertices.
+ */
+TEST(ReorderWeightTest, PermuteTest)
+{
+  csr_graph graph(
+    edge_index_vector({0, 2, 3, 3}),
+    vertex_index_vector({1, 2, 0}),
+    double_vector({0.5, 1.5, 2.5}),
+    double_vector({10, 20, 30})
+  );
+  csr_graph permuted = permute_vertices(graph, {2, 0, 1});
+  ASSERT_EQ(double_vector({20, 30, 10}), double_vector(
+    permuted.values(), permuted.values() + 3
+  ));
+  // old 0 -> {1, 2} is new 2 -> {0, 1}, old 1 -> 0 is new 0 -> 2
+  ASSERT_EQ(0U, permuted.degree(1));
+  ASSERT_EQ(2U, permuted.target(0));
+  ASSERT_EQ(2.5, permuted.weight(0));
+  ASSERT_EQ(0U, permuted.target(1));
+  ASSERT_EQ(0.5, permuted.weight(1));
+  ASSERT_EQ(1U, permuted.target(2));
+  ASSERT_EQ(1.5, permuted.weight(2));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
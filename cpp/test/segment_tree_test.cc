@@ -0,0 +1,111 @@
+/**
+ * @file segment_tree_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for the lazy propagation segment tree
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/segment_tree.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with random integer-valued data, so sums are exact.
+ *
+ * The size is not a power of two, so the tree has padding leaves.
+ */
+class SegmentTreeTest : public ::testing::Test {
+protected:
+  SegmentTreeTest() : rng_(71), values_(n_values_)
+  {
+    for (double& value : values_) {
+      value = static_cast<double>(rng_() % 100);
+    }
+  }
+
+  /**
+   * Return a random non-empty range `[begin, end)`.
+   */
+  std::pair<std::size_t, std::size_t> random_range()
+  {
+    std::size_t begin = rng_() % n_values_;
+    std::size_t end = begin + 1 + rng_() % (n_values_ - begin);
+    return {begin, end};
+  }
+
+  static constexpr std::size_t n_values_ = 300;
+  std::mt19937_64 rng_;
+  double_vector values_;
+};
+
+/**
+ * Test that an empty tree and empty ranges give identity aggregates.
+ */
+TEST_F(SegmentTreeTest, EmptyTest)
+{
+  segment_tree empty;
+  ASSERT_EQ(0, empty.size());
+  ASSERT_TRUE(empty.values().empty());
+  segment_tree tree(values_);
+  ASSERT_EQ(0, tree.sum(5, 5));
+  ASSERT_EQ(std::numeric_limits<double>::infinity(), tree.min(5, 5));
+  ASSERT_EQ(-std::numeric_limits<double>::infinity(), tree.max(5, 5));
+}
+
+/**
+ * Test random interleaved updates and queries against a plain array.
+ */
+TEST_F(SegmentTreeTest, RandomOperationsTest)
+{
+  segment_tree tree(values_);
+  ASSERT_EQ(n_values_, tree.size());
+  ASSERT_EQ(values_, tree.values());
+  for (std::size_t i = 0; i < 3000; i++) {
+    auto [begin, end] = random_range();
+    auto first = values_.begin() + begin;
+    auto last = values_.begin() + end;
+    auto amount = static_cast<double>(rng_() % 100) - 50;
+    switch (rng_() % 3) {
+      case 0:
+        tree.add(begin, end, amount);
+        std::for_each(first, last, [&](double& value) { value += amount; });
+        break;
+      case 1:
+        tree.assign(begin, end, amount);
+        std::fill(first, last, amount);
+        break;
+      default: {
+        double sum = 0;
+        std::for_each(first, last, [&](double value) { sum += value; });
+        ASSERT_EQ(sum, tree.sum(begin, end));
+        ASSERT_EQ(*std::min_element(first, last), tree.min(begin, end));
+        ASSERT_EQ(*std::max_element(first, last), tree.max(begin, end));
+        std::size_t pos = begin + rng_() % (end - begin);
+        ASSERT_EQ(values_[pos], tree.value(pos));
+      }
+    }
+  }
+  ASSERT_EQ(values_, tree.values());
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
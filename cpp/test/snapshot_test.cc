@@ -0,0 +1,176 @@
+/**
+ * @file snapshot_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for binary graph snapshots in snapshot.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/snapshot.h"
+
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/compressed_graph.h"
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/kcore.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture providing a temporary snapshot path.
+ */
+class SnapshotTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor picking a snapshot path in the temporary directory.
+   */
+  SnapshotTest()
+    : path_(
+        (
+          std::filesystem::temp_directory_path() / "pdcip_snapshot_test.bin"
+        ).string()
+      )
+  {}
+
+  /**
+   * Destructor removing the snapshot file.
+   */
+  ~SnapshotTest() { std::filesystem::remove(path_); }
+
+  /**
+   * Check that two graphs have identical arrays.
+   *
+   * @param expected `const csr_graph&` expected graph
+   * @param actual `const csr_graph&` actual graph
+   */
+  void check_equal(const csr_graph& expected, const csr_graph& actual)
+  {
+    ASSERT_EQ(expected.n_vertices(), actual.n_vertices());
+    ASSERT_EQ(expected.n_edges(), actual.n_edges());
+    ASSERT_EQ(expected.weighted(), actual.weighted());
+    for (vertex_index v = 0; v < expected.n_vertices(); v++) {
+      ASSERT_EQ(expected.edges_begin(v), actual.edges_begin(v));
+      ASSERT_EQ(expected.edges_end(v), actual.edges_end(v));
+      if (std::isnan(expected.value(v))) {
+        ASSERT_TRUE(std::isnan(actual.value(v)));
+      }
+      else {
+        ASSERT_EQ(expected.value(v), actual.value(v));
+      }
+    }
+    for (edge_index e = 0; e < expected.n_edges(); e++) {
+      ASSERT_EQ(expected.target(e), actual.target(e));
+      ASSERT_EQ(expected.weight(e), actual.weight(e));
+    }
+  }
+
+  std::string path_;
+};
+
+/**
+ * Test writing and reopening a weighted graph with vertex values.
+ */
+TEST_F(SnapshotTest, RoundTripTest)
+{
+  csr_graph graph(
+    edge_index_vector({0, 2, 3, 3}),
+    vertex_index_vector({1, 2, 0}),
+    double_vector({0.5, 1.5, -2}),
+    double_vector({10, 20, 30})
+  );
+  ASSERT_TRUE(write_snapshot(graph, path_));
+  std::optional<csr_graph> mapped = open_snapshot(path_);
+  ASSERT_TRUE(mapped);
+  check_equal(graph, *mapped);
+  // copies share the mapping, which outlives the original
+  csr_graph copy = *mapped;
+  mapped.reset();
+  check_equal(graph, copy);
+}
+
+/**
+ * Test that algorithms run directly on a mapped unweighted graph.
+ */
+TEST_F(SnapshotTest, AlgorithmTest)
+{
+  std::size_t n_vertices = 400;
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<vertex_index> dist(0, n_vertices - 1);
+  vertex_index_vector sources(3000);
+  vertex_index_vector targets(sources.size());
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    sources[i] = dist(rng);
+    targets[i] = dist(rng);
+  }
+  csr_graph graph = csr_graph(n_vertices, sources, targets).symmetrize();
+  ASSERT_TRUE(write_snapshot(graph, path_));
+  std::optional<csr_graph> mapped = open_snapshot(path_);
+  ASSERT_TRUE(mapped);
+  check_equal(graph, *mapped);
+  ASSERT_EQ(core_numbers(graph), core_numbers(*mapped));
+  // transforms of a mapped graph are ordinary in-memory graphs
+  check_equal(graph.transpose(), mapped->transpose());
+}
+
+/**
+ * Test compressing a snapshot straight from its mapping.
+ */
+TEST_F(SnapshotTest, CompressedTest)
+{
+  ASSERT_FALSE(open_compressed_snapshot(path_));
+  csr_graph graph(
+    5,
+    vertex_index_vector({0, 0, 1, 3, 4, 4}),
+    vertex_index_vector({1, 4, 2, 0, 3, 4}),
+    double_vector({1, 2, 3, 4, 5, 6})
+  );
+  ASSERT_TRUE(write_snapshot(graph, path_));
+  std::optional<compressed_graph> compressed = open_compressed_snapshot(
+    path_, 2
+  );
+  ASSERT_TRUE(compressed);
+  check_equal(graph, compressed->decompress());
+}
+
+/**
+ * Test that files that are not valid snapshots are rejected.
+ */
+TEST_F(SnapshotTest, InvalidTest)
+{
+  ASSERT_FALSE(open_snapshot(path_));
+  csr_graph graph(3, vertex_index_vector({0, 1}), vertex_index_vector({1, 2}));
+  ASSERT_TRUE(write_snapshot(graph, path_));
+  // bump the version
+  {
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offsetof(snapshot_header, version));
+    char version = static_cast<char>(snapshot_version + 1);
+    file.write(&version, 1);
+  }
+  ASSERT_FALSE(open_snapshot(path_));
+  // truncate
+  ASSERT_TRUE(write_snapshot(graph, path_));
+  std::filesystem::resize_file(path_, sizeof(snapshot_header) + 8);
+  ASSERT_FALSE(open_snapshot(path_));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,382 @@
+/**
+ * @file tree_diff_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for diffing and patching trees in tree_diff.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/tree_diff.h"
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/enums.h"
+#include "pdcip/cpp/merkle.h"
+#include "pdcip/cpp/tree.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Test fixture with a source tree, an equal replica, and a target to edit.
+ *
+ * The three trees are built from the same seed, so node `i` of each is the
+ * same node. Every node's parent has a smaller label, so moving node `i`
+ * under a node with a smaller label can never create a cycle.
+ */
+class TreeDiffTest : public ::testing::Test {
+protected:
+  /**
+   * Constructor building the trees.
+   */
+  TreeDiffTest()
+    : source_(make_tree(source_nodes_)),
+      replica_(make_tree(replica_nodes_)),
+      target_(make_tree(target_nodes_))
+  {}
+
+  /**
+   * Return a random tree, the same one on every call.
+   *
+   * @param nodes `tree_ptr_vector&` filled with the nodes by label
+   */
+  static tree_ptr make_tree(tree_ptr_vector& nodes)
+  {
+    std::mt19937 rng(75);
+    nodes.clear();
+    for (std::size_t i = 0; i < n_nodes_; i++) {
+      nodes.push_back(
+        std::make_shared<tree>(static_cast<double>(rng() % 1000))
+      );
+    }
+    std::vector<tree_ptr_vector> children(n_nodes_);
+    for (std::size_t i = 1; i < n_nodes_; i++) {
+      children[rng() % i].push_back(nodes[i]);
+    }
+    for (std::size_t i = 0; i < n_nodes_; i++) {
+      nodes[i]->set_children(std::make_shared<tree_ptr_vector>(children[i]));
+    }
+    return nodes[0];
+  }
+
+  /**
+   * Return the label of the parent of a target node, `n_nodes_` if none.
+   *
+   * @param label `std::size_t` label of a target node
+   */
+  std::size_t target_parent(std::size_t label) const
+  {
+    for (std::size_t i = 0; i < n_nodes_; i++) {
+      for (const tree_ptr& child : *target_nodes_[i]->children()) {
+        if (child == target_nodes_[label]) {
+          return i;
+        }
+      }
+    }
+    return n_nodes_;
+  }
+
+  /**
+   * Remove a node from its parent in the target, if it has one.
+   *
+   * @param label `std::size_t` label of a target node
+   */
+  void detach(std::size_t label)
+  {
+    std::size_t parent_label = target_parent(label);
+    if (parent_label == n_nodes_) {
+      return;
+    }
+    const tree_ptr& parent = target_nodes_[parent_label];
+    auto children = std::make_shared<tree_ptr_vector>();
+    for (const tree_ptr& child : *parent->children()) {
+      if (child != target_nodes_[label]) {
+        children->push_back(child);
+      }
+    }
+    parent->set_children(std::move(children));
+  }
+
+  /**
+   * Insert a node under a target node at a position.
+   *
+   * @param parent `std::size_t` label of the target parent
+   * @param position `std::size_t` position among the parent's children
+   * @param node `const tree_ptr&` node to insert
+   */
+  void attach(std::size_t parent, std::size_t position, const tree_ptr& node)
+  {
+    auto children = std::make_shared<tree_ptr_vector>(
+      *target_nodes_[parent]->children()
+    );
+    children->insert(children->begin() + position, node);
+    target_nodes_[parent]->set_children(std::move(children));
+  }
+
+  /**
+   * Return a label of a node with at least two children, from the bottom.
+   */
+  std::size_t branching_node() const
+  {
+    for (std::size_t i = n_nodes_; i-- > 1; ) {
+      if (target_nodes_[i]->n_children() >= 2) {
+        return i;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * Diff source and target, patch the replica, and check the result.
+   *
+   * @returns `tree_patch` that was applied
+   */
+  tree_patch diff_and_patch() const
+  {
+    tree_patch patch = diff_trees(source_, target_);
+    EXPECT_EQ(merkle_hashes(source_).root_hash(), patch.source_hash);
+    EXPECT_EQ(merkle_hashes(replica_).root_hash(), patch.source_hash);
+    EXPECT_EQ(merkle_hashes(target_).root_hash(), patch.target_hash);
+    EXPECT_TRUE(apply_tree_patch(replica_, patch));
+    EXPECT_EQ(patch.target_hash, merkle_hashes(replica_).root_hash());
+    EXPECT_EQ(
+      *tree::value_vector(tree::dfs(target_)),
+      *tree::value_vector(tree::dfs(replica_))
+    );
+    return patch;
+  }
+
+  static constexpr std::size_t n_nodes_ = 2000;
+  tree_ptr_vector source_nodes_;
+  tree_ptr_vector replica_nodes_;
+  tree_ptr_vector target_nodes_;
+  tree_ptr source_;
+  tree_ptr replica_;
+  tree_ptr target_;
+};
+
+/**
+ * Test that equal trees give an empty patch.
+ */
+TEST_F(TreeDiffTest, EqualTest)
+{
+  tree_patch patch = diff_and_patch();
+  ASSERT_EQ(n_nodes_, patch.source_size);
+  ASSERT_EQ(patch.source_hash, patch.target_hash);
+  ASSERT_TRUE(patch.edits.empty());
+}
+
+/**
+ * Test that a value update is one edit naming the node by `tree::dfs` order.
+ */
+TEST_F(TreeDiffTest, UpdateTest)
+{
+  target_nodes_[700]->set_value(-1);
+  tree_patch patch = diff_and_patch();
+  ASSERT_EQ(1, patch.edits.size());
+  ASSERT_EQ(tree_edit_type::update, patch.edits[0].type);
+  ASSERT_EQ(-1, patch.edits[0].value);
+  ASSERT_EQ(source_nodes_[700], tree::dfs(source_)->at(patch.edits[0].node));
+  ASSERT_EQ(-1, replica_nodes_[700]->value());
+}
+
+/**
+ * Test that inserting and removing leaves and subtrees are one edit each.
+ */
+TEST_F(TreeDiffTest, InsertRemoveTest)
+{
+  std::size_t parent = branching_node();
+  attach(parent, 1, std::make_shared<tree>(-5));
+  detach(1500);
+  tree_patch patch = diff_and_patch();
+  ASSERT_EQ(2, patch.edits.size());
+  std::size_t n_inserts = 0;
+  for (const tree_edit& edit : patch.edits) {
+    if (edit.type == tree_edit_type::insert) {
+      n_inserts++;
+      ASSERT_EQ(n_nodes_, edit.node);
+      ASSERT_EQ(1, edit.position);
+      ASSERT_EQ(-5, edit.value);
+    }
+    else {
+      ASSERT_EQ(tree_edit_type::remove, edit.type);
+    }
+  }
+  ASSERT_EQ(1, n_inserts);
+  ASSERT_EQ(-5, replica_nodes_[parent]->children()->at(1)->value());
+}
+
+/**
+ * Test that moving a subtree elsewhere is one edit.
+ */
+TEST_F(TreeDiffTest, MoveTest)
+{
+  // move a subtree with children up under the root
+  std::size_t label = branching_node();
+  detach(label);
+  attach(0, 0, target_nodes_[label]);
+  tree_patch patch = diff_and_patch();
+  ASSERT_EQ(1, patch.edits.size());
+  ASSERT_EQ(tree_edit_type::move, patch.edits[0].type);
+  ASSERT_EQ(replica_nodes_[label], replica_->children()->front());
+}
+
+/**
+ * Test that swapping two children is one move.
+ */
+TEST_F(TreeDiffTest, ReorderTest)
+{
+  const tree_ptr& parent = target_nodes_[branching_node()];
+  auto children = std::make_shared<tree_ptr_vector>(*parent->children());
+  std::swap((*children)[0], (*children)[1]);
+  parent->set_children(std::move(children));
+  tree_patch patch = diff_and_patch();
+  ASSERT_EQ(1, patch.edits.size());
+  ASSERT_EQ(tree_edit_type::move, patch.edits[0].type);
+}
+
+/**
+ * Test that many random edits give a patch far smaller than the tree.
+ */
+TEST_F(TreeDiffTest, RandomEditsTest)
+{
+  std::mt19937 rng(7500);
+  std::size_t n_changes = 40;
+  for (std::size_t i = 0; i < n_changes; i++) {
+    std::size_t label = 1 + rng() % (n_nodes_ - 1);
+    switch (i % 4) {
+      case 0:
+        target_nodes_[label]->set_value(-static_cast<double>(i));
+        break;
+      case 1:
+        detach(label);
+        break;
+      case 2: {
+        std::size_t parent = rng() % label;
+        std::size_t n_children = target_nodes_[parent]->n_children();
+        attach(
+          parent,
+          rng() % (n_children + 1),
+          std::make_shared<tree>(static_cast<double>(i))
+        );
+        break;
+      }
+      default: {
+        // parents always have smaller labels, so this can't make a cycle
+        std::size_t parent = rng() % label;
+        detach(label);
+        std::size_t n_children = target_nodes_[parent]->n_children();
+        attach(parent, rng() % (n_children + 1), target_nodes_[label]);
+        break;
+      }
+    }
+  }
+  tree_patch patch = diff_and_patch();
+  ASSERT_FALSE(patch.edits.empty());
+  ASSERT_GE(2 * n_changes, patch.edits.size());
+}
+
+/**
+ * Test that patches not fitting the tree are refused without changing it.
+ */
+TEST_F(TreeDiffTest, InvalidPatchTest)
+{
+  // one move of a node with children, so the node numbered before it in the
+  // source is its last child
+  std::size_t label = branching_node();
+  detach(label);
+  attach(0, 0, target_nodes_[label]);
+  tree_patch patch = diff_trees(source_, target_);
+  ASSERT_EQ(1, patch.edits.size());
+  ASSERT_EQ(tree_edit_type::move, patch.edits[0].type);
+  auto hash = merkle_hashes(replica_).root_hash();
+  // each corruption is applied to a fresh copy of the patch
+  auto refused = [&](auto corrupt)
+  {
+    tree_patch bad = patch;
+    corrupt(bad);
+    return !apply_tree_patch(replica_, bad) &&
+      merkle_hashes(replica_).root_hash() == hash;
+  };
+  auto n_source = static_cast<vertex_index>(n_nodes_);
+  ASSERT_TRUE(refused([](tree_patch& bad) { bad.source_size++; }));
+  ASSERT_TRUE(
+    refused(
+      [&](tree_patch& bad)
+      {
+        bad.edits.push_back({tree_edit_type::update, n_source, 0, 0, 1.});
+      }
+    )
+  );
+  // inserts out of order or past the end of their parent's children
+  ASSERT_TRUE(
+    refused(
+      [&](tree_patch& bad)
+      {
+        bad.edits.push_back({tree_edit_type::insert, n_source + 1, 0, 0, 1.});
+      }
+    )
+  );
+  ASSERT_TRUE(
+    refused(
+      [&](tree_patch& bad)
+      {
+        bad.edits.push_back(
+          {tree_edit_type::insert, n_source, 0, n_source, 1.}
+        );
+      }
+    )
+  );
+  // detaching the root or the same node twice
+  ASSERT_TRUE(
+    refused([&](tree_patch& bad) { bad.edits[0].node = n_source - 1; })
+  );
+  ASSERT_TRUE(
+    refused([](tree_patch& bad) { bad.edits.push_back(bad.edits[0]); })
+  );
+  // moving a node under its own child
+  ASSERT_TRUE(
+    refused(
+      [](tree_patch& bad)
+      {
+        bad.edits[0].parent = bad.edits[0].node - 1;
+        bad.edits[0].position = 0;
+      }
+    )
+  );
+  // the untouched patch still applies
+  ASSERT_TRUE(apply_tree_patch(replica_, patch));
+  ASSERT_EQ(patch.target_hash, merkle_hashes(replica_).root_hash());
+  ASSERT_EQ(replica_nodes_[label], replica_->children()->front());
+}
+
+/**
+ * Test that trees of `tree` subclasses are refused.
+ */
+TEST(TreeDiffTypeTest, SubclassTest)
+{
+  auto root = std::make_shared<binary_tree>(
+    2, std::make_shared<binary_tree>(1), std::make_shared<binary_tree>(3)
+  );
+  tree_patch patch = diff_trees(root, root);
+  ASSERT_EQ(3, patch.source_size);
+  ASSERT_FALSE(apply_tree_patch(root, patch));
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip
@@ -0,0 +1,139 @@
+/**
+ * @file triangles_test.cc
+ * @author Derek Huang
+ * @brief Unit tests for triangle counting in triangles.cc and intersect.cc
+ * @copyright MIT License
+ */
+
+#include "pdcip/cpp/triangles.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "pdcip/cpp/csr_graph.h"
+#include "pdcip/cpp/intersect.h"
+#include "pdcip/cpp/types.h"
+#include "pdcip/cpp/testing/msvc.h"
+
+#ifdef _MSC_VER
+#pragma warning (disable: GTEST_FIXTURE_WARNINGS)
+#endif  // _MSC_VER
+
+namespace pdcip {
+namespace testing {
+
+namespace {
+
+/**
+ * Return a random sorted list of unique vertex indices.
+ *
+ * @param rng `std::mt19937&` random number generator
+ * @param size `std::size_t` maximum list size
+ */
+vertex_index_vector random_sorted_set(std::mt19937& rng, std::size_t size)
+{
+  std::uniform_int_distribution<vertex_index> dist(0, 3 * size);
+  vertex_index_vector values(size);
+  for (vertex_index& value : values) {
+    value = dist(rng);
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+/**
+ * Test that the SIMD intersection matches the scalar one.
+ */
+TEST(IntersectTest, SimdMatchesScalarTest)
+{
+  std::mt19937 rng(11);
+  for (std::size_t trial = 0; trial < 200; trial++) {
+    vertex_index_vector a = random_sorted_set(rng, trial % 37);
+    vertex_index_vector b = random_sorted_set(rng, trial % 53);
+    vertex_index_vector expected(std::min(a.size(), b.size()));
+    vertex_index_vector actual(expected.size());
+    std::size_t n_expected = intersect_sorted_scalar(
+      a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+      expected.data()
+    );
+    std::size_t n_actual = intersect_sorted(
+      a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+      actual.data()
+    );
+    ASSERT_EQ(n_expected, n_actual);
+    expected.resize(n_expected);
+    actual.resize(n_actual);
+    ASSERT_EQ(expected, actual);
+    ASSERT_EQ(
+      n_expected,
+      intersect_sorted(
+        a.data(), a.data() + a.size(), b.data(), b.data() + b.size()
+      )
+    );
+  }
+}
+
+/**
+ * Test triangle counts on a 4-clique with a pendant vertex.
+ */
+TEST(TrianglesTest, CliqueTest)
+{
+  csr_graph graph = csr_graph(
+    5,
+    vertex_index_vector({0, 0, 0, 1, 1, 2, 3}),
+    vertex_index_vector({1, 2, 3, 2, 3, 3, 4})
+  ).symmetrize();
+  ASSERT_EQ(4, count_triangles(graph, 2));
+  triangle_stats stats = local_clustering(graph, 2);
+  ASSERT_EQ(4, stats.n_triangles);
+  ASSERT_EQ(edge_index_vector({3, 3, 3, 3, 0}), stats.vertex_triangles);
+  ASSERT_DOUBLE_EQ(1, stats.clustering[0]);
+  ASSERT_DOUBLE_EQ(0.5, stats.clustering[3]);
+  ASSERT_DOUBLE_EQ(0, stats.clustering[4]);
+}
+
+/**
+ * Test triangle counts against brute force on a random graph.
+ */
+TEST(TrianglesTest, RandomTest)
+{
+  std::size_t n_vertices = 60;
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<vertex_index> dist(0, n_vertices - 1);
+  vertex_index_vector sources(600);
+  vertex_index_vector targets(600);
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    sources[i] = dist(rng);
+    targets[i] = dist(rng);
+  }
+  csr_graph graph = csr_graph(n_vertices, sources, targets).symmetrize();
+  std::size_t expected = 0;
+  edge_index_vector expected_vertex(n_vertices, 0);
+  for (vertex_index u = 0; u < n_vertices; u++) {
+    for (vertex_index v = u + 1; v < n_vertices; v++) {
+      for (vertex_index w = v + 1; w < n_vertices; w++) {
+        if (
+          graph.has_edge(u, v) && graph.has_edge(v, w) && graph.has_edge(u, w)
+        ) {
+          expected++;
+          expected_vertex[u]++;
+          expected_vertex[v]++;
+          expected_vertex[w]++;
+        }
+      }
+    }
+  }
+  ASSERT_EQ(expected, count_triangles(graph, 4));
+  triangle_stats stats = local_clustering(graph, 4);
+  ASSERT_EQ(expected, stats.n_triangles);
+  ASSERT_EQ(expected_vertex, stats.vertex_triangles);
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace pdcip